@@ -55,7 +55,6 @@ const double PADDLE_SPEED = 600.0;
 const double DEFAULT_ELASTICITY = 1.0;
 const double BALL_RADIUS = 10.0;
 const rgb_color_t BALL_COLOR = (rgb_color_t){1, 0, 0};
-const size_t BALL_NUM_POINTS = 40;
 const double BALL_MASS = 1.0;
 const vector_t BALL_INITIAL_VELOCITY = (vector_t){400, 800};
 
@@ -91,17 +90,6 @@ double rand_double(double lower_bound, double upper_bound) {
   return return_num;
 }
 
-list_t *make_circle(double radius, size_t num_points) {
-  list_t *polygon = list_init(num_points, free);
-  double step_size = 2 * M_PI / num_points;
-  for (size_t i = 0; i < num_points; i++) {
-    vector_t *to_add = malloc(sizeof(*to_add));
-    *to_add = vec_rotate((vector_t){radius, 0}, i * step_size);
-    list_add(polygon, to_add);
-  }
-  return polygon;
-}
-
 vector_t calculate_brick_position(size_t row, size_t col) {
   double spacing = WINDOW.x / BRICKS_PER_ROW;
   double x_pos = spacing / 2;
@@ -129,10 +117,10 @@ list_t *make_rectangle(double width, double height) {
 }
 
 body_t *make_ball() {
-  list_t *shape = make_circle(BALL_RADIUS, BALL_NUM_POINTS);
   body_type_t *type = malloc(sizeof(*type));
   *type = BALL;
-  body_t *ball = body_init_with_info(shape, BALL_MASS, BALL_COLOR, type, free);
+  body_t *ball = body_init_circle(VEC_ZERO, BALL_RADIUS, BALL_MASS,
+                                  BALL_COLOR, type, free);
   return ball;
 }
 
@@ -1,9 +1,12 @@
+#include "bike.h"
 #include "body.h"
 #include "collision.h"
 #include "color.h"
 #include "forces.h"
+#include "heightfield.h"
 #include "list.h"
 #include "polygon.h"
+#include "pool.h"
 #include "scene.h"
 #include "sdl_wrapper.h"
 #include "state.h"
@@ -16,12 +19,14 @@
 
 // constants
 const vector_t WINDOW = ((vector_t){.x = 2000, .y = 1000});
+// roughly the size of the larger level, so loading it does not grow the scene
+const size_t SCENE_NUM_BODIES = 128;
+const size_t SCENE_NUM_FORCES = 256;
 #define CENTER vec_multiply(0.5, WINDOW)
 #define STARTING_POSITION                                                      \
   (vector_t) { WINDOW.x / 2.0, 0.5 * WINDOW.y }
 
 // button constants
-const double BUTTON_MASS = 1.0;
 #define BUTTON_DIM                                                             \
   (vector_t) { 0.2 * WINDOW.x, 0.15 * WINDOW.y }
 #define BACK_BUTTON_DIM                                                        \
@@ -87,52 +92,15 @@ const rgb_color_t WHITE = {1.0, 1.0, 1.0};
 const rgb_color_t YELLOW = {0.5, 0.5, 0.0};
 
 // bike constants
-const size_t BIKE_NUM_POINTS = 500;
 const double BIKE_MASS = 1.0;
 const double BIKE_MOMENT = 0.75;
 const rgb_color_t BIKE_COLOR = (rgb_color_t){0.5, 0, 0};
 const vector_t START = (vector_t){-1.45, 1.045};
 const double BIKE_SCALING_FACTOR = 10.0;
-// 1
-// each section's end point becomes the next section's start point.
-#define NUM_SECTIONS 54
-#define NUM_CURVES 19
-const vector_t COORDS[NUM_SECTIONS] = {
-    (vector_t){-0.6, 1.0249},    (vector_t){-1.05, 1.191},
-    (vector_t){-1.1, 1.412},     (vector_t){-0.8752, 2.7991},
-    (vector_t){-0.35, 2.336},    (vector_t){0.417, 1.9778},
-    (vector_t){0.6441, 1.9888},  (vector_t){0.8, 1.8933},
-    (vector_t){0.94, 1.5667},    (vector_t){-1.788, 0.8834},
-    (vector_t){-8.6, 1.0551},    (vector_t){-4.306, -0.4199},
-    (vector_t){-6.58, -1.2912},  (vector_t){-6.42, -1.7088},
-    (vector_t){-5.611, -1.3999}, (vector_t){-5.772, -0.9804},
-    (vector_t){-5.345, -0.8174}, (vector_t){-5.185, -1.236},
-    (vector_t){-3.99, -0.7786},  (vector_t){-3.752, -1.1},
-    (vector_t){-1.6274, -1.1},   (vector_t){-0.6476, -1.1},
-    (vector_t){0.2912, -1.1},    (vector_t){1.53, 0.1899},
-    (vector_t){2.2932, -1.5851}, (vector_t){2.7068, -1.4149},
-    (vector_t){2.364, -0.616},   (vector_t){1.9514, 0.7936},
-    (vector_t){1.771, -0.3737},  (vector_t){2.184, -0.1961},
-    (vector_t){1.9708, 0.3014},  (vector_t){4.5, -0.09585},
-    (vector_t){3.5, 0.7268},     (vector_t){1.69, 0.9567},
-    (vector_t){1.22, 2.0501},    (vector_t){0.741, 2.3056},
-    (vector_t){0.5566, 2.4422},  (vector_t){-0.2, 2.78},
-    (vector_t){-0.83, 3.595},    (vector_t){-0.86, 3.7},
-    (vector_t){-0.9148, 3.748},  (vector_t){-0.3925, 3.675},
-    (vector_t){-0.25, 3.96},     (vector_t){-0.37, 3.96},
-    (vector_t){-0.7, 4.05},      (vector_t){-0.8, 4.19},
-    (vector_t){-0.71, 4.703},    (vector_t){-0.5529, 4.904},
-    (vector_t){0.0861, 4.91},    (vector_t){-0.4122, 5.228},
-    (vector_t){-1.701, 3.858},   (vector_t){-1.587, 3.842},
-    (vector_t){-2.125, 0.9167},  (vector_t){-0.5, 0.988},
-};
-
-const double PROPORTIONS[NUM_CURVES] = {
-    3.0 / 100.0, 1.0 / 100.0, 4.5 / 100.0, 6.0 / 100.0, 4.5 / 100.0,
-    1.5 / 100.0, 4.5 / 100.0, 6.0 / 100.0, 1.5 / 100.0, 3.0 / 100.0,
-    6.5 / 100.0, 2.5 / 100.0, 2.0 / 100.0, 1.0 / 100.0, 4.0 / 100.0,
-    6.0 / 100.0, 2.0 / 100.0, 1.0 / 100.0, 4.5 / 100.0,
-};
+// how far the bike's collision shape may stray from its drawn outline, a
+// quarter pixel; test_bike_simplification checks that at this tolerance
+// (0.025 before BIKE_SCALING_FACTOR) the outline keeps under half its vertices
+const double BIKE_COLLISION_TOLERANCE = 0.25;
 
 const double TRACK_SCALING_FACTOR = 90.0;
 const double TRACK_BUFFER = 30.0;
@@ -486,7 +454,6 @@ const size_t POWERUP_SCORE = 1000;
 
 // track constants
 const double TRACK_HEIGHT = 20.0;
-const double TRACK_MASS = INFINITY;
 const rgb_color_t TRACK_ONE_COLOR = {0.545098039216, 0.270588235294,
                                      0.0745098039216};
 const rgb_color_t TRACK_TWO_COLOR = {0.0, 0.2, 0.4};
@@ -516,7 +483,12 @@ const double POWERUP_SCALE = 2.0;
 const double VERTICAL_SHIFT = 100.0;
 const double POWERUP_TIME = 10.0;
 
-typedef list_t *(*track_t)();
+#ifdef COLLISION_STATS
+// ticks between reports of the separating axis cache's hit rate
+const size_t STATS_REPORT_TICKS = 600;
+#endif
+
+typedef list_t *(*track_t)(arena_t *arena);
 
 typedef enum { BIKE = 1, TRACK = 2, STAR = 3, FINISH = 4 } body_type_t;
 
@@ -531,6 +503,8 @@ typedef struct state {
   scene_t *scene;
   list_t *bodies;
   list_t *forces;
+  // the bike's drag, until it is removed once the bike slows down
+  force_t *drag;
   double clock;
   double dt;
   text_input_t timer_text;
@@ -555,6 +529,10 @@ typedef struct state {
   double bike_acceleration;
   double bike_max_speed;
   double past_angle;
+#ifdef COLLISION_STATS
+  // ticks since the level started, for the axis cache reports
+  size_t stats_ticks;
+#endif
 } state_t;
 
 // helper functions
@@ -564,290 +542,7 @@ void button_free(button_t *button) {
   free(button);
 }
 
-// bike functions
-void section_two(list_t *shape, vector_t start, vector_t end,
-                 size_t num_points) {
-  double dx = (end.x - start.x) / num_points;
-  vector_t *coord_zero = malloc(sizeof(vector_t));
-  *coord_zero = start;
-  list_add(shape, coord_zero);
-  for (size_t t = 1; t < num_points; t++) {
-    double x = start.x + dx * t;
-    double y = 2 + 0.5 * sinh(10 * (x + 1));
-    vector_t *coord = malloc(sizeof(vector_t));
-    *coord = (vector_t){x, y};
-    list_add(shape, coord);
-  }
-}
-
-void section_five(list_t *shape, vector_t start, vector_t end,
-                  size_t num_points) {
-  double dx = (end.x - start.x) / num_points;
-  vector_t *coord_zero = malloc(sizeof(vector_t));
-  *coord_zero = start;
-  list_add(shape, coord_zero);
-  for (size_t t = 1; t < num_points; t++) {
-    double x = start.x + dx * t;
-    double y = 2.2 - sqrt(0.06 - (x - 0.52) * (x - 0.52));
-    vector_t *coord = malloc(sizeof(vector_t));
-    *coord = (vector_t){x, y};
-    list_add(shape, coord);
-  }
-}
-
-void section_eight(list_t *shape, vector_t start, vector_t end,
-                   size_t num_points) {
-  double dx = (end.x - start.x) / num_points;
-  vector_t *coord_zero = malloc(sizeof(vector_t));
-  *coord_zero = start;
-  list_add(shape, coord_zero);
-  for (size_t t = 1; t < num_points; t++) {
-    double x = start.x + dx * t;
-    double y = 0.95 - 0.34 * cos(0.7 * x - 1) / (x - 1.46);
-    vector_t *coord = malloc(sizeof(vector_t));
-    *coord = (vector_t){x, y};
-    list_add(shape, coord);
-  }
-}
-
-void section_nine(list_t *shape, vector_t start, vector_t end,
-                  size_t num_points) {
-  double dx = (end.x - start.x) / num_points;
-  vector_t *coord_zero = malloc(sizeof(vector_t));
-  *coord_zero = start;
-  list_add(shape, coord_zero);
-  for (size_t t = 1; t < num_points; t++) {
-    double x = start.x + dx * t;
-    double y = 1.005 + 0.15 * cos(0.55 * x + 3.5);
-    vector_t *coord = malloc(sizeof(vector_t));
-    *coord = (vector_t){x, y};
-    list_add(shape, coord);
-  }
-}
-
-void section_ten(list_t *shape, vector_t start, vector_t end,
-                 size_t num_points) {
-  double dx = (end.x - start.x) / num_points;
-  vector_t *coord_zero = malloc(sizeof(vector_t));
-  *coord_zero = start;
-  list_add(shape, coord_zero);
-  for (size_t t = 1; t < num_points; t++) {
-    double x = start.x + dx * t;
-    double y = 1.15 - exp(0.65 * (x + 5.0));
-    vector_t *coord = malloc(sizeof(vector_t));
-    *coord = (vector_t){x, y};
-    list_add(shape, coord);
-  }
-}
-
-void section_twelve(list_t *shape, vector_t start, size_t num_points) {
-  vector_t *coord_zero = malloc(sizeof(vector_t));
-  *coord_zero = start;
-  list_add(shape, coord_zero);
-  double dt = M_PI / num_points;
-  for (size_t i = 1; i < num_points; i++) {
-    double t = 0.61646 * M_PI + dt * i;
-    double x = 0.22361 * cos(t) - 6.5;
-    double y = 0.22361 * sin(t) - 1.5;
-    vector_t *coord = malloc(sizeof(vector_t));
-    *coord = (vector_t){x, y};
-    list_add(shape, coord);
-  }
-}
-
-void section_fourteen(list_t *shape, vector_t start, size_t num_points) {
-  double interval_length = 5.7735;
-  double interval_start = 1.4606;
-  vector_t *coord_zero = malloc(sizeof(vector_t));
-  *coord_zero = start;
-  list_add(shape, coord_zero);
-  double dt = interval_length / num_points;
-  for (size_t i = 1; i < num_points; i++) {
-    double t = interval_start + dt * i;
-    double x = 0.89443 * sin(t) - 6.5;
-    double y = 0.89443 * cos(t) - 1.5;
-    vector_t *coord = malloc(sizeof(vector_t));
-    *coord = (vector_t){x, y};
-    list_add(shape, coord);
-  }
-}
-
-void section_sixteen(list_t *shape, vector_t start, size_t num_points) {
-  double interval_length = 5.946;
-  double interval_start = 0.534;
-  vector_t *coord_zero = malloc(sizeof(vector_t));
-  *coord_zero = start;
-  list_add(shape, coord_zero);
-  double dt = interval_length / num_points;
-  for (size_t i = 1; i < num_points; i++) {
-    double t = interval_start + dt * i;
-    double x = 1.3416 * cos(t) - 6.5;
-    double y = 1.3416 * sin(t) - 1.5;
-    vector_t *coord = malloc(sizeof(vector_t));
-    *coord = (vector_t){x, y};
-    list_add(shape, coord);
-  }
-}
-
-void section_twenty(list_t *shape, vector_t start, vector_t end,
-                    size_t num_points) {
-  double dx = (end.x - start.x) / num_points;
-  vector_t *coord_zero = malloc(sizeof(vector_t));
-  *coord_zero = start;
-  list_add(shape, coord_zero);
-  for (size_t t = 1; t < num_points; t++) {
-    double x = start.x + dx * t;
-    double y = -1.4 - 1.0 / (24 * (x + 1.2) * (x + 1.2) - 3 * (x + 1.2) - 9);
-    vector_t *coord = malloc(sizeof(vector_t));
-    *coord = (vector_t){x, y};
-    list_add(shape, coord);
-  }
-}
-
-void section_twenty_two(list_t *shape, vector_t start, vector_t end,
-                        size_t num_points) {
-  double dx = (end.x - start.x) / num_points;
-  vector_t *coord_zero = malloc(sizeof(vector_t));
-  *coord_zero = start;
-  list_add(shape, coord_zero);
-  for (size_t t = 1; t < num_points; t++) {
-    double x = start.x + dx * t;
-    double y = 2.0 - 4.0 * cosh(0.4 * (x - 0.2)) / (x + 1);
-    vector_t *coord = malloc(sizeof(vector_t));
-    *coord = (vector_t){x, y};
-    list_add(shape, coord);
-  }
-}
-
-void section_twenty_four(list_t *shape, vector_t start, size_t num_points) {
-  double interval_length = 3.141;
-  double interval_start = 3.532;
-  vector_t *coord_zero = malloc(sizeof(vector_t));
-  *coord_zero = start;
-  list_add(shape, coord_zero);
-  double dt = interval_length / num_points;
-  for (size_t i = 1; i < num_points; i++) {
-    double t = interval_start + dt * i;
-    double x = 0.22361 * cos(t) + 2.5;
-    double y = 0.22361 * sin(t) - 1.5;
-    vector_t *coord = malloc(sizeof(vector_t));
-    *coord = (vector_t){x, y};
-    list_add(shape, coord);
-  }
-}
-
-void section_twenty_six(list_t *shape, vector_t start, size_t num_points) {
-  double interval_length = 5.47;
-  double interval_start = -0.1525;
-  vector_t *coord_zero = malloc(sizeof(vector_t));
-  *coord_zero = start;
-  list_add(shape, coord_zero);
-  double dt = interval_length / num_points;
-  for (size_t i = 1; i < num_points; i++) {
-    double t = interval_start + dt * i;
-    double x = 0.89443 * sin(t) + 2.5;
-    double y = 0.89443 * cos(t) - 1.5;
-    vector_t *coord = malloc(sizeof(vector_t));
-    *coord = (vector_t){x, y};
-    list_add(shape, coord);
-  }
-}
-
-void section_twenty_eight(list_t *shape, vector_t start, size_t num_points) {
-  double interval_length = 5.94;
-  double interval_start = 2.15;
-  vector_t *coord_zero = malloc(sizeof(vector_t));
-  *coord_zero = start;
-  list_add(shape, coord_zero);
-  double dt = interval_length / num_points;
-  for (size_t i = 1; i < num_points; i++) {
-    double t = interval_start + dt * i;
-    double x = 1.3416 * cos(t) + 2.5;
-    double y = 1.3416 * sin(t) - 1.5;
-    vector_t *coord = malloc(sizeof(vector_t));
-    *coord = (vector_t){x, y};
-    list_add(shape, coord);
-  }
-}
-
-void section_thirty(list_t *shape, vector_t start, vector_t end,
-                    size_t num_points) {
-  double dx = (end.x - start.x) / num_points;
-  vector_t *coord_zero = malloc(sizeof(vector_t));
-  *coord_zero = start;
-  list_add(shape, coord_zero);
-  for (size_t t = 1; t < num_points; t++) {
-    double x = start.x + dx * t;
-    double y = 2.0 - 4.0 * cosh(0.4 * (x - 0.2)) / (x + 1);
-    vector_t *coord = malloc(sizeof(vector_t));
-    *coord = (vector_t){x, y};
-    list_add(shape, coord);
-  }
-}
-
-void section_thirty_two(list_t *shape, vector_t start, vector_t end,
-                        size_t num_points) {
-  double dx = (end.x - start.x) / num_points;
-  vector_t *coord_zero = malloc(sizeof(vector_t));
-  *coord_zero = start;
-  list_add(shape, coord_zero);
-  for (size_t t = 1; t < num_points; t++) {
-    double x = start.x + dx * t;
-    double y = 0.7 + 0.6 * sqrt(0.1 * (3.52 - x));
-    vector_t *coord = malloc(sizeof(vector_t));
-    *coord = (vector_t){x, y};
-    list_add(shape, coord);
-  }
-}
-
-void section_thirty_five(list_t *shape, vector_t start, vector_t end,
-                         size_t num_points) {
-  double dx = (end.x - start.x) / num_points;
-  vector_t *coord_zero = malloc(sizeof(vector_t));
-  *coord_zero = start;
-  list_add(shape, coord_zero);
-  for (size_t t = 1; t < num_points; t++) {
-    double x = start.x + dx * t;
-    double y = 2.2 + sqrt(0.06 - (x - 0.52) * (x - 0.52));
-    vector_t *coord = malloc(sizeof(vector_t));
-    *coord = (vector_t){x, y};
-    list_add(shape, coord);
-  }
-}
-
-void section_forty_nine(list_t *shape, vector_t start, size_t num_points) {
-  vector_t *coord_zero = malloc(sizeof(vector_t));
-  double interval_length = 0.9526 * M_PI;
-  double interval_start = 0.3 * M_PI;
-  *coord_zero = start;
-  list_add(shape, coord_zero);
-  double dt = interval_length / num_points;
-  for (size_t i = 1; i < num_points; i++) {
-    double t = interval_start + dt * i;
-    double x = cos(t) - 1;
-    double y = 0.9 * sin(t) + 4.5;
-    vector_t *coord = malloc(sizeof(vector_t));
-    *coord = (vector_t){x, y};
-    list_add(shape, coord);
-  }
-}
-
-void section_fifty_one(list_t *shape, vector_t start, vector_t end,
-                       size_t num_points) {
-  double dx = (end.x - start.x) / num_points;
-  vector_t *coord_zero = malloc(sizeof(vector_t));
-  *coord_zero = start;
-
-  list_add(shape, coord_zero);
-  for (size_t t = 1; t < num_points; t++) {
-    double x = start.x + dx * t;
-    double y = 4.0 + (x + 1.2) / (4.0 * (x + 2.2));
-    vector_t *coord = malloc(sizeof(vector_t));
-    *coord = (vector_t){x, y};
-    list_add(shape, coord);
-  }
-}
-
+// shape functions
 list_t *scale_polygon(double scalar, list_t *list) {
   list_t *scaled_polygon = list_init(list_size(list), free);
   for (size_t i = 0; i < list_size(list); i++) {
@@ -858,145 +553,94 @@ list_t *scale_polygon(double scalar, list_t *list) {
   return scaled_polygon;
 }
 
-list_t *make_bike_shape() {
-  list_t *shape = list_init(BIKE_NUM_POINTS, free);
-  size_t j = 0;
-  for (size_t i = 0; i < NUM_SECTIONS; i++) {
-    if (i == 2) {
-      section_two(shape, COORDS[i], COORDS[i + 1],
-                  PROPORTIONS[j] * BIKE_NUM_POINTS);
-      j++;
-    }
-    if (i == 5) {
-      section_five(shape, COORDS[i], COORDS[i + 1],
-                   PROPORTIONS[j] * BIKE_NUM_POINTS);
-      j++;
-    } else if (i == 8) {
-      section_eight(shape, COORDS[i], COORDS[i + 1],
-                    PROPORTIONS[j] * BIKE_NUM_POINTS);
-      j++;
-    } else if (i == 9) {
-      section_nine(shape, COORDS[i], COORDS[i + 1],
-                   PROPORTIONS[j] * BIKE_NUM_POINTS);
-      j++;
-    } else if (i == 10) {
-      section_ten(shape, COORDS[i], COORDS[i + 1],
-                  PROPORTIONS[j] * BIKE_NUM_POINTS);
-      j++;
-    } else if (i == 12) {
-      section_twelve(shape, COORDS[i], PROPORTIONS[j] * BIKE_NUM_POINTS);
-      j++;
-    } else if (i == 14) {
-      section_fourteen(shape, COORDS[i], PROPORTIONS[j] * BIKE_NUM_POINTS);
-      j++;
-    } else if (i == 16) {
-      section_sixteen(shape, COORDS[i], PROPORTIONS[j] * BIKE_NUM_POINTS);
-      j++;
-    } else if (i == 18) {
-      section_ten(shape, COORDS[i], COORDS[i + 1],
-                  PROPORTIONS[j] * BIKE_NUM_POINTS);
-      j++;
-    } else if (i == 20) {
-      section_twenty(shape, COORDS[i], COORDS[i + 1],
-                     PROPORTIONS[j] * BIKE_NUM_POINTS);
-      j++;
-    } else if (i == 22) {
-      section_twenty_two(shape, COORDS[i], COORDS[i + 1],
-                         PROPORTIONS[j] * BIKE_NUM_POINTS);
-    } else if (i == 24) {
-      section_twenty_four(shape, COORDS[i], PROPORTIONS[j] * BIKE_NUM_POINTS);
-    } else if (i == 26) {
-      section_twenty_six(shape, COORDS[i], PROPORTIONS[j] * BIKE_NUM_POINTS);
-    } else if (i == 28) {
-      section_twenty_eight(shape, COORDS[i], PROPORTIONS[j] * BIKE_NUM_POINTS);
-    } else if (i == 30) {
-      section_thirty(shape, COORDS[i], COORDS[i + 1],
-                     PROPORTIONS[j] * BIKE_NUM_POINTS);
-    } else if (i == 32) {
-      section_thirty_two(shape, COORDS[i], COORDS[i + 1],
-                         PROPORTIONS[j] * BIKE_NUM_POINTS);
-    } else if (i == 35) {
-      section_thirty_five(shape, COORDS[i], COORDS[i + 1],
-                          PROPORTIONS[j] * BIKE_NUM_POINTS);
-    } else if (i == 49) {
-      section_forty_nine(shape, COORDS[i], PROPORTIONS[j] * BIKE_NUM_POINTS);
-    } else if (i == 51) {
-      section_fifty_one(shape, COORDS[i], COORDS[i + 1],
-                        PROPORTIONS[j] * BIKE_NUM_POINTS);
-    } else {
-      vector_t *coord = malloc(sizeof(vector_t));
-      *coord = COORDS[i];
-      list_add(shape, coord);
-    }
-  }
-  return shape;
-}
-
 // track functions
-list_t *make_track_one() {
-  list_t *bodies = list_init(NUM_BODIES1, NULL);
-  size_t i = 0;
-  for (size_t j = 0; j < NUM_BODIES1; j++) {
+// Adds a heightfield body for the samples so far, if they make up a column
+void add_track_heightfield(arena_t *arena, list_t *bodies, list_t *samples,
+                           rgb_color_t color) {
+  if (list_size(samples) < 2) {
+    list_free(samples);
+    return;
+  }
+  body_type_t *type = malloc(sizeof(*type));
+  *type = TRACK;
+  heightfield_t *heightfield = heightfield_init(samples, TRACK_BUFFER);
+  list_add(bodies,
+           body_init_heightfield_in(arena, heightfield, color, type, free));
+}
+
+// Each track segment is a quad whose corners run from its bottom left to its
+// bottom right. The top layer is what the bike rides on. The ground below it
+// is only drawn, since the top layer covers all of it except the very bottom.
+// The top layers of neighbouring segments join up into one heightfield,
+// which is only broken where the track has a gap.
+list_t *make_track(arena_t *arena, const vector_t *coords,
+                   size_t num_segments, rgb_color_t color,
+                   rgb_color_t top_color) {
+  list_t *heightfields = list_init(1, NULL);
+  list_t *decorations = list_init(num_segments, NULL);
+  list_t *samples = list_init(num_segments + 1, free);
+  for (size_t j = 0; j < num_segments; j++) {
     list_t *shape = list_init(4, free);
     for (size_t k = 0; k < 4; k++) {
       vector_t *coord = malloc(sizeof(vector_t));
-      *coord = TRACK_ONE_COORDS[i + k];
+      *coord = coords[4 * j + k];
       list_add(shape, coord);
     }
-    list_t *new_shape1 = scale_polygon(TRACK_SCALING_FACTOR, shape);
-    list_t *new_shape2 = scale_polygon(TRACK_SCALING_FACTOR, shape);
-    polygon_translate(new_shape2, (vector_t){0, TRACK_BUFFER});
+    list_t *ground_shape = scale_polygon(TRACK_SCALING_FACTOR, shape);
+    list_add(decorations, body_init_decoration_in(arena, ground_shape, color));
+    vector_t top_left =
+        vec_add(vec_multiply(TRACK_SCALING_FACTOR, coords[4 * j + 1]),
+                (vector_t){0, TRACK_BUFFER});
+    vector_t top_right =
+        vec_add(vec_multiply(TRACK_SCALING_FACTOR, coords[4 * j + 2]),
+                (vector_t){0, TRACK_BUFFER});
+    vector_t *last = list_size(samples) > 0
+                         ? list_get(samples, list_size(samples) - 1)
+                         : NULL;
+    if (last == NULL || last->x != top_left.x || last->y != top_left.y) {
+      add_track_heightfield(arena, heightfields, samples, top_color);
+      samples = list_init(num_segments + 1, free);
+      vector_t *sample = malloc(sizeof(vector_t));
+      *sample = top_left;
+      list_add(samples, sample);
+    }
+    vector_t *sample = malloc(sizeof(vector_t));
+    *sample = top_right;
+    list_add(samples, sample);
     list_free(shape);
-    i += 4;
-    body_type_t *type = malloc(sizeof(*type));
-    *type = TRACK;
-    body_t *body1 = body_init_with_info(new_shape1, TRACK_MASS, TRACK_ONE_COLOR,
-                                        type, free);
-    body_t *body2 =
-        body_init_with_info(new_shape2, TRACK_MASS, GREEN, type, free);
-    list_add(bodies, body2);
-    list_add(bodies, body1);
   }
-  return bodies;
+  add_track_heightfield(arena, heightfields, samples, top_color);
+  // The top layer is drawn first, so the ground covers its lower part
+  for (size_t i = 0; i < list_size(decorations); i++) {
+    list_add(heightfields, list_get(decorations, i));
+  }
+  list_free(decorations);
+  return heightfields;
 }
 
-list_t *make_track_two() {
-  list_t *bodies = list_init(NUM_BODIES2, NULL);
-  size_t i = 0;
-  for (size_t j = 0; j < NUM_BODIES2; j++) {
-    list_t *shape = list_init(4, free);
-    for (size_t k = 0; k < 4; k++) {
-      vector_t *coord = malloc(sizeof(vector_t));
-      *coord = TRACK_TWO_COORDS[i + k];
-      list_add(shape, coord);
-    }
-    list_t *new_shape1 = scale_polygon(TRACK_SCALING_FACTOR, shape);
-    list_t *new_shape2 = scale_polygon(TRACK_SCALING_FACTOR, shape);
-    polygon_translate(new_shape2, (vector_t){0, TRACK_BUFFER});
-    list_free(shape);
-    i += 4;
-    body_type_t *type = malloc(sizeof(*type));
-    *type = TRACK;
-    body_t *body1 = body_init_with_info(new_shape1, TRACK_MASS, TRACK_TWO_COLOR,
-                                        type, free);
-    body_t *body2 =
-        body_init_with_info(new_shape2, TRACK_MASS, BLUE, type, free);
-    list_add(bodies, body2);
-    list_add(bodies, body1);
-  }
-  return bodies;
+list_t *make_track_one(arena_t *arena) {
+  return make_track(arena, TRACK_ONE_COORDS, NUM_BODIES1, TRACK_ONE_COLOR,
+                    GREEN);
+}
+
+list_t *make_track_two(arena_t *arena) {
+  return make_track(arena, TRACK_TWO_COORDS, NUM_BODIES2, TRACK_TWO_COLOR,
+                    BLUE);
 }
 
-body_t *make_bike(rgb_color_t color) {
+body_t *make_bike(arena_t *arena, rgb_color_t color) {
   list_t *shape = make_bike_shape();
   list_t *scaled_shape = scale_polygon(10, shape);
   list_free(shape);
   body_type_t *type = malloc(sizeof(*type));
   *type = BIKE;
-  body_t *bike =
-      body_init_with_info(scaled_shape, BIKE_MASS, color, type, free);
+  body_t *bike = body_init_with_info_in(arena, scaled_shape, BIKE_MASS, color,
+                                        type, free);
   body_set_centroid(bike, STARTING_POSITION); //
   body_set_normal_moment_of_inertia(bike, BIKE_MOMENT);
+  body_set_collision_tolerance(bike, BIKE_COLLISION_TOLERANCE);
+  // Slow frames mean long ticks, which must not carry the bike through a track
+  body_set_bullet(bike, true);
   return bike;
 }
 
@@ -1037,7 +681,9 @@ body_t *make_star(state_t *state, double scale_factor) {
                                   STAR_NUM_POINTS, scale_factor);
   body_type_t *type = malloc(sizeof(*type));
   *type = STAR;
-  body_t *star = body_init_with_info(shape, STAR_MASS, STAR_COLOR, type, free);
+  body_t *star = body_init_with_info_in(scene_get_body_arena(state->scene),
+                                        shape, STAR_MASS, STAR_COLOR, type,
+                                        free);
   if (state->level == 1) {
     body_set_centroid(star, STAR_POSITION_TRACK_1);
   } else {
@@ -1047,8 +693,7 @@ body_t *make_star(state_t *state, double scale_factor) {
   return star;
 }
 
-body_t *make_rectangle_with_info(double width, double height, rgb_color_t color,
-                                 void *info, free_func_t freer) {
+list_t *make_rectangle_shape(double width, double height) {
   vector_t *bottom_left = malloc(sizeof(vector_t));
   *bottom_left = (vector_t){0, 0};
   vector_t *top_left = malloc(sizeof(vector_t));
@@ -1062,29 +707,23 @@ body_t *make_rectangle_with_info(double width, double height, rgb_color_t color,
   list_add(rectangle_shape, top_left);
   list_add(rectangle_shape, top_right);
   list_add(rectangle_shape, bottom_right);
-  body_t *rectangle =
-      body_init_with_info(rectangle_shape, BUTTON_MASS, color, info, freer);
-  return rectangle;
-}
-
-body_t *make_rectangle(double width, double height, rgb_color_t color) {
-  return make_rectangle_with_info(width, height, color, NULL, NULL);
+  return rectangle_shape;
 }
 
 void initialize_body_list(state_t *state, track_t make_track) {
   sdl_clear_text();
   assert(scene_bodies(state->scene) == 0);
-  scene_add_body(state->scene, make_bike(state->bike_color));
-  list_t *bodies = make_track();
+  // The level's bodies are released all at once when the scene is reset
+  arena_t *arena = scene_get_body_arena(state->scene);
+  scene_add_body(state->scene, make_bike(arena, state->bike_color));
+  list_t *bodies = make_track(arena);
   for (size_t i = 0; i < list_size(bodies); i++) {
     body_t *body = list_get(bodies, i);
     scene_add_body(state->scene, body);
   }
   list_free(bodies);
-  body_type_t *finish_type = malloc(sizeof(body_type_t));
-  *finish_type = FINISH;
-  body_t *finish = make_rectangle_with_info(FINISH_WIDTH, FINISH_HEIGHT, WHITE,
-                                            finish_type, free);
+  body_t *finish = body_init_decoration_in(
+      arena, make_rectangle_shape(FINISH_WIDTH, FINISH_HEIGHT), WHITE);
   vector_t centroid =
       (vector_t){state->goal + 0.5 * FINISH_WIDTH, 0.5 * FINISH_HEIGHT};
   body_set_centroid(finish, centroid);
@@ -1097,50 +736,37 @@ bool double_is_close(double a, double b, double threshold) {
   return fabs(a - b) < threshold;
 }
 
-list_t *create_triangle(double side) {
-  list_t *triangle = list_init(3, free);
-  vector_t *v1 = malloc(sizeof(vector_t));
-  *v1 = (vector_t){side / 2.0, -sqrt(3) / 2 * side};
-  vector_t *v2 = malloc(sizeof(vector_t));
-  *v2 = (vector_t){-side / 2.0, -sqrt(3) / 2 * side};
-  vector_t *v3 = malloc(sizeof(vector_t));
-  *v3 = (vector_t){0, side};
-  list_add(triangle, v1);
-  list_add(triangle, v2);
-  list_add(triangle, v3);
+// Allocates the triangle from arena if it is non-NULL, or else on the heap
+polygon_t *create_triangle(arena_t *arena, double side) {
+  polygon_t *triangle =
+      arena != NULL ? polygon_init_in(arena, 3) : polygon_init(3);
+  polygon_add_vertex(triangle, (vector_t){side / 2.0, -sqrt(3) / 2 * side});
+  polygon_add_vertex(triangle, (vector_t){-side / 2.0, -sqrt(3) / 2 * side});
+  polygon_add_vertex(triangle, (vector_t){0, side});
   return triangle;
 }
 
-list_t *create_collision_triangle() { return create_triangle(0.0001); }
-
-vector_t find_colliding_point(body_t *body1, body_t *body2) {
-  list_t *body1_shape = body_get_shape(body1);
-  list_t *body2_shape = body_get_shape(body2);
-  for (size_t i = 0; i < list_size(body1_shape); i++) {
-    vector_t centroid = *(vector_t *)list_get(body1_shape, i);
-    list_t *triangle = create_collision_triangle();
-    polygon_translate(triangle, centroid);
-    collision_info_t collision = find_collision(triangle, body2_shape);
-    if (collision.collided) {
-      list_free(body1_shape);
-      list_free(body2_shape);
-      return centroid;
-    }
+polygon_t *create_collision_triangle(arena_t *arena) {
+  return create_triangle(arena, 0.0001);
+}
+
+// The deepest contact point of a ground contact's cached collision, which
+// the collision force creator has already computed this tick
+vector_t find_colliding_point(contact_t *contact) {
+  collision_info_t collision = contact_get_collision(contact);
+  if (!collision.collided) {
+    return vec_negate(WINDOW);
   }
-  list_free(body1_shape);
-  list_free(body2_shape);
-  return vec_negate(WINDOW);
+  return collision.contacts[0];
 }
 
 void ground_collision(body_t *body, body_t *ground, vector_t axis, void *aux) {
   const double COLLISION_ERROR = 1e-5;
   const double ANGULAR_ERROR = 0.04;
-  list_t *wheel_shape = body_get_shape(body);
-  list_t *track_shape = body_get_shape(ground);
   double angle_diff = body_get_rotation(body) - vec_angle(axis);
   if (!double_is_close(fabs(angle_diff), PI_HALF, ANGULAR_ERROR) &&
       !double_is_close(fabs(angle_diff), THREE_PI_HALF, ANGULAR_ERROR)) {
-    vector_t intersect = find_colliding_point(body, ground);
+    vector_t intersect = find_colliding_point(*(contact_t **)aux);
     if (!double_is_close(intersect.x, -WINDOW.x, COLLISION_ERROR)) {
       body_set_pivot(body, intersect);
       if (angle_diff > -PI_HALF) {
@@ -1153,13 +779,14 @@ void ground_collision(body_t *body, body_t *ground, vector_t axis, void *aux) {
     } else {
       body_set_angular_velocity(body, 0.0);
     }
-    list_free(wheel_shape);
-    list_free(track_shape);
   }
 }
 
 void create_ground_collision(state_t *state, body_t *body, body_t *ground) {
-  create_collision(state->scene, body, ground, ground_collision, state, free);
+  // The handler reads its pivot from the pair's contact
+  contact_t **contact = scene_alloc_record(state->scene, sizeof(contact_t *));
+  *contact = force_get_contact(create_collision(
+      state->scene, body, ground, ground_collision, contact, pool_release));
 }
 
 void collect_powerup(body_t *bike, body_t *star, vector_t axis, void *aux) {
@@ -1191,9 +818,12 @@ void initialize_force_list(state_t *state) {
   body_t *bike = scene_get_body(state->scene, 0);
   assert(*(body_type_t *)body_get_info(bike) == BIKE);
   create_downwards_gravity(state->scene, GRAVITATIONAL_ACCELERATION, bike);
-  create_drag(state->scene, DRAG, bike);
+  state->drag = create_drag(state->scene, DRAG, bike);
   for (size_t i = 1; i < scene_bodies(state->scene); i++) {
     body_t *body = scene_get_body(state->scene, i);
+    if (body_is_decoration(body)) {
+      continue;
+    }
     body_type_t *type = body_get_info(body);
     if (*type == TRACK) {
       create_ground_collision(state, bike, body);
@@ -1252,7 +882,26 @@ void initialize_game(state_t *state) {
   } else if (state->game_state == SCORE) {
     state->score = 0;
   }
+#ifdef COLLISION_STATS
+  collision_reset_axis_cache_stats();
+  state->stats_ticks = 0;
+#endif
+}
+
+#ifdef COLLISION_STATS
+// Prints how often the separating axis cache has shown the bike apart from
+// the level's bodies without the full test, every STATS_REPORT_TICKS ticks
+void report_axis_cache_stats(state_t *state) {
+  state->stats_ticks++;
+  if (state->stats_ticks % STATS_REPORT_TICKS != 0) {
+    return;
+  }
+  axis_cache_stats_t stats = collision_get_axis_cache_stats();
+  printf("level %zu, %zu ticks: %zu/%zu axis cache hits (%.0f%%)\n",
+         state->level, state->stats_ticks, stats.hits, stats.lookups,
+         stats.lookups > 0 ? 100.0 * stats.hits / stats.lookups : 0.0);
 }
+#endif
 
 // keyboard controls for bike
 void on_key(state_t *state, char key, key_event_type_t type, double held_time) {
@@ -1343,8 +992,10 @@ void make_button(state_t *state, char *string, size_t font_size,
                              .dim = dim,
                              .color = text_color};
   sdl_write_text(text_input, "Montserrat", "SemiBold");
-  body_t *button = make_rectangle(BUTTON_SCALING_FACTOR * dim.x,
-                                  BUTTON_SCALING_FACTOR * dim.y, button_color);
+  body_t *button = body_init_decoration(
+      make_rectangle_shape(BUTTON_SCALING_FACTOR * dim.x,
+                           BUTTON_SCALING_FACTOR * dim.y),
+      button_color);
   vector_t centroid = (vector_t){position.x + dim.x / CENTROID_SCALING_FACTOR,
                                  position.y - dim.y / CENTROID_SCALING_FACTOR};
   body_set_centroid(button, centroid);
@@ -1376,7 +1027,8 @@ void reset_scene(state_t *state) {
     free(button);
   }
   scene_free(state->scene);
-  state->scene = scene_init();
+  state->scene = scene_init_with_capacity(SCENE_NUM_BODIES, SCENE_NUM_FORCES);
+  state->drag = NULL;
   sdl_clear_text();
   sdl_render_scene(state->scene);
 }
@@ -1529,11 +1181,11 @@ void create_win_menu(state_t *state) {
 // start menu mouse handler
 void on_mouse_start_menu(state_t *state, char key, key_event_type_t type,
                          double x, double y) {
-  list_t *collision_tester = create_collision_triangle();
-  polygon_translate(collision_tester, (vector_t){x, y});
+  polygon_t *collision_tester = create_collision_triangle(NULL);
+  polygon_translate_vertices(collision_tester, (vector_t){x, y});
   button_t *button;
   body_t *button_box;
-  list_t *button_shape;
+  const polygon_t *button_shape;
   collision_info_t collision;
   if (type == MOUSE_BUTTON_RELEASED) {
     switch (key) {
@@ -1541,8 +1193,8 @@ void on_mouse_start_menu(state_t *state, char key, key_event_type_t type,
       for (size_t i = 0; i < list_size(state->button_list); i++) {
         button = list_get(state->button_list, i);
         button_box = button->body;
-        button_shape = body_get_shape(button_box);
-        collision = find_collision(collision_tester, button_shape);
+        button_shape = body_get_polygon(button_box);
+        collision = find_polygon_collision(collision_tester, button_shape);
         if (collision.collided) {
           switch (i) {
           case 0:
@@ -1562,20 +1214,19 @@ void on_mouse_start_menu(state_t *state, char key, key_event_type_t type,
           break;
         }
       }
-      list_free(button_shape);
     }
   }
-  list_free(collision_tester);
+  polygon_free(collision_tester);
 }
 
 // color menu mouse handler
 void on_mouse_color_menu(state_t *state, char key, key_event_type_t type,
                          double x, double y) {
-  list_t *collision_tester = create_collision_triangle();
-  polygon_translate(collision_tester, (vector_t){x, y});
+  polygon_t *collision_tester = create_collision_triangle(NULL);
+  polygon_translate_vertices(collision_tester, (vector_t){x, y});
   button_t *button;
   body_t *button_box;
-  list_t *button_shape;
+  const polygon_t *button_shape;
   collision_info_t collision;
   if (type == MOUSE_BUTTON_RELEASED) {
     switch (key) {
@@ -1583,8 +1234,8 @@ void on_mouse_color_menu(state_t *state, char key, key_event_type_t type,
       for (size_t i = 0; i < list_size(state->button_list); i++) {
         button = list_get(state->button_list, i);
         button_box = button->body;
-        button_shape = body_get_shape(button_box);
-        collision = find_collision(collision_tester, button_shape);
+        button_shape = body_get_polygon(button_box);
+        collision = find_polygon_collision(collision_tester, button_shape);
         if (collision.collided) {
           switch (i) {
           case 0:
@@ -1619,20 +1270,19 @@ void on_mouse_color_menu(state_t *state, char key, key_event_type_t type,
           break;
         }
       }
-      list_free(button_shape);
     }
   }
-  list_free(collision_tester);
+  polygon_free(collision_tester);
 }
 
 // game menu mouse handler
 void on_mouse_game_menu(state_t *state, char key, key_event_type_t type,
                         double x, double y) {
-  list_t *collision_tester = create_collision_triangle();
-  polygon_translate(collision_tester, (vector_t){x, y});
+  polygon_t *collision_tester = create_collision_triangle(NULL);
+  polygon_translate_vertices(collision_tester, (vector_t){x, y});
   button_t *button;
   body_t *button_box;
-  list_t *button_shape;
+  const polygon_t *button_shape;
   collision_info_t collision;
   if (type == MOUSE_BUTTON_RELEASED) {
     switch (key) {
@@ -1640,8 +1290,8 @@ void on_mouse_game_menu(state_t *state, char key, key_event_type_t type,
       for (size_t i = 0; i < list_size(state->button_list); i++) {
         button = list_get(state->button_list, i);
         button_box = button->body;
-        button_shape = body_get_shape(button_box);
-        collision = find_collision(collision_tester, button_shape);
+        button_shape = body_get_polygon(button_box);
+        collision = find_polygon_collision(collision_tester, button_shape);
         if (collision.collided) {
           switch (i) {
           case 0:
@@ -1662,20 +1312,19 @@ void on_mouse_game_menu(state_t *state, char key, key_event_type_t type,
           break;
         }
       }
-      list_free(button_shape);
     }
   }
-  list_free(collision_tester);
+  polygon_free(collision_tester);
 }
 
 // game menu mouse handler
 void on_mouse_level_menu(state_t *state, char key, key_event_type_t type,
                          double x, double y) {
-  list_t *collision_tester = create_collision_triangle();
-  polygon_translate(collision_tester, (vector_t){x, y});
+  polygon_t *collision_tester = create_collision_triangle(NULL);
+  polygon_translate_vertices(collision_tester, (vector_t){x, y});
   button_t *button;
   body_t *button_box;
-  list_t *button_shape;
+  const polygon_t *button_shape;
   collision_info_t collision;
   if (type == MOUSE_BUTTON_RELEASED) {
     switch (key) {
@@ -1683,8 +1332,8 @@ void on_mouse_level_menu(state_t *state, char key, key_event_type_t type,
       for (size_t i = 0; i < list_size(state->button_list); i++) {
         button = list_get(state->button_list, i);
         button_box = button->body;
-        button_shape = body_get_shape(button_box);
-        collision = find_collision(collision_tester, button_shape);
+        button_shape = body_get_polygon(button_box);
+        collision = find_polygon_collision(collision_tester, button_shape);
         if (collision.collided) {
           switch (i) {
           case 0:
@@ -1707,19 +1356,18 @@ void on_mouse_level_menu(state_t *state, char key, key_event_type_t type,
           break;
         }
       }
-      list_free(button_shape);
     }
   }
-  list_free(collision_tester);
+  polygon_free(collision_tester);
 }
 
 void on_mouse_game_over_menu(state_t *state, char key, key_event_type_t type,
                              double x, double y) {
-  list_t *collision_tester = create_collision_triangle();
-  polygon_translate(collision_tester, (vector_t){x, y});
+  polygon_t *collision_tester = create_collision_triangle(NULL);
+  polygon_translate_vertices(collision_tester, (vector_t){x, y});
   button_t *button;
   body_t *button_box;
-  list_t *button_shape;
+  const polygon_t *button_shape;
   collision_info_t collision;
   if (type == MOUSE_BUTTON_RELEASED) {
     switch (key) {
@@ -1727,8 +1375,8 @@ void on_mouse_game_over_menu(state_t *state, char key, key_event_type_t type,
       for (size_t i = 0; i < list_size(state->button_list); i++) {
         button = list_get(state->button_list, i);
         button_box = button->body;
-        button_shape = body_get_shape(button_box);
-        collision = find_collision(collision_tester, button_shape);
+        button_shape = body_get_polygon(button_box);
+        collision = find_polygon_collision(collision_tester, button_shape);
         if (collision.collided) {
           switch (i) {
           case 0:
@@ -1769,10 +1417,9 @@ void on_mouse_game_over_menu(state_t *state, char key, key_event_type_t type,
           }
         }
       }
-      list_free(button_shape);
     }
   }
-  list_free(collision_tester);
+  polygon_free(collision_tester);
 }
 
 void on_mouse_controls_menu(state_t *state, char key, key_event_type_t type,
@@ -1792,9 +1439,10 @@ state_t *emscripten_init() {
   vector_t max = WINDOW;
   sdl_init(min, max);
   state_t *state = malloc(sizeof(state_t));
-  state->scene = scene_init();
+  state->scene = scene_init_with_capacity(SCENE_NUM_BODIES, SCENE_NUM_FORCES);
   state->bodies = list_init(1, NULL);
   state->forces = list_init(1, NULL);
+  state->drag = NULL;
   state->bike_color = RED;
   state->game_state = MENU;
   state->button_list = list_init(3, free);
@@ -1865,23 +1513,36 @@ void update_score(state_t *state) {
 bool check_track_collision(state_t *state) {
   const double COLLISION_TEST_SIZE = 100.0;
   body_t *bike = scene_get_body(state->scene, 0);
-  list_t *bike_triangle = create_triangle(COLLISION_TEST_SIZE);
-  polygon_translate(bike_triangle, body_get_pivot(bike));
+  polygon_t *bike_triangle =
+      create_triangle(scene_get_scratch(state->scene), COLLISION_TEST_SIZE);
+  polygon_translate_vertices(bike_triangle, body_get_pivot(bike));
   assert(scene_bodies(state->scene) > 1);
   for (size_t i = 0; i < scene_bodies(state->scene); i++) {
     body_t *track = scene_get_body(state->scene, i);
+    if (body_is_decoration(track)) {
+      continue;
+    }
     body_type_t *type = body_get_info(track);
-    if (*type == TRACK) {
-      list_t *track_shape = body_get_shape(track);
-      collision_info_t collision = find_collision(bike_triangle, track_shape);
-      list_free(track_shape);
-      if (collision.collided) {
-        list_free(bike_triangle);
+    if (*type != TRACK) {
+      continue;
+    }
+    aabb_t bounds = polygon_get_bounds(bike_triangle);
+    size_t first, end;
+    body_find_parts(track, bounds, &first, &end);
+    for (size_t j = first; j < end; j++) {
+      const polygon_t *part = body_get_part(track, j);
+      if (!aabb_overlaps(bounds, polygon_get_bounds(part))) {
+        continue;
+      }
+      // Only whether they touch matters, so there is no need for SAT's
+      // axis and contact points
+      distance_info_t distance = find_convex_distance(
+          support_polygon(bike_triangle, 0), support_polygon(part, 0));
+      if (distance.collided) {
         return true;
       }
     }
   }
-  list_free(bike_triangle);
   return false;
 }
 
@@ -1952,8 +1613,10 @@ void emscripten_main(state_t *state) {
     if (state->powerup_timer < 0.0 && state->has_powerup) {
       kill_powerup(state);
     }
-    if (double_is_close(vec_magn(body_get_velocity(bike)), 0.0, 50.0)) {
-      scene_remove_force(state->scene, (force_creator_t)drag_creator);
+    if (state->drag != NULL &&
+        double_is_close(vec_magn(body_get_velocity(bike)), 0.0, 50.0)) {
+      scene_remove_force_creator(state->scene, state->drag);
+      state->drag = NULL;
     }
     bool collision_checker = check_track_collision(state);
     if (!state->in_air && !collision_checker) {
@@ -1993,8 +1656,10 @@ void emscripten_main(state_t *state) {
     if (state->powerup_timer < 0.0 && state->has_powerup) {
       kill_powerup(state);
     }
-    if (double_is_close(vec_magn(body_get_velocity(bike)), 0.0, 50.0)) {
-      scene_remove_force(state->scene, (force_creator_t)drag_creator);
+    if (state->drag != NULL &&
+        double_is_close(vec_magn(body_get_velocity(bike)), 0.0, 50.0)) {
+      scene_remove_force_creator(state->scene, state->drag);
+      state->drag = NULL;
     }
     bool collision_checker = check_track_collision(state);
     if (!state->in_air && !collision_checker) {
@@ -2016,6 +1681,11 @@ void emscripten_main(state_t *state) {
     }
     scene_tick(state->scene, state->dt);
   }
+#ifdef COLLISION_STATS
+  if (state->level != 0 && !state->game_over) {
+    report_axis_cache_stats(state);
+  }
+#endif
   sdl_render_scene(state->scene);
 }
 
@@ -9,8 +9,6 @@
 #include <stdlib.h>
 #include <time.h>
 
-#define CIRCLE_POINTS 40
-
 #define MAX ((vector_t){.x = 80.0, .y = 80.0})
 
 #define N_ROWS 11
@@ -80,20 +78,6 @@ list_t *rect_init(double width, double height) {
   return rect;
 }
 
-/** Constructs a circles with the given radius centered at (0, 0) */
-list_t *circle_init(double radius) {
-  list_t *circle = list_init(CIRCLE_POINTS, free);
-  double arc_angle = 2 * M_PI / CIRCLE_POINTS;
-  vector_t point = {.x = radius, .y = 0.0};
-  for (size_t i = 0; i < CIRCLE_POINTS; i++) {
-    vector_t *v = malloc(sizeof(*v));
-    *v = point;
-    list_add(circle, v);
-    point = vec_rotate(point, arc_angle);
-  }
-  return circle;
-}
-
 /** Computes the center of the peg in the given row and column */
 vector_t get_peg_center(size_t row, size_t col) {
   vector_t center = {.x = MAX.x / 2 + (col - row * 0.5) * COL_SPACING,
@@ -116,11 +100,8 @@ void add_gravity_body(scene_t *scene) {
 
 /** Creates a ball with the given starting position and velocity */
 body_t *get_ball(vector_t center, vector_t velocity) {
-  list_t *shape = circle_init(BALL_RADIUS);
-  body_t *ball = body_init_with_info(shape, BALL_MASS, BALL_COLOR,
-                                     make_type_info(BALL), free);
-
-  body_set_centroid(ball, center);
+  body_t *ball = body_init_circle(center, BALL_RADIUS, BALL_MASS, BALL_COLOR,
+                                  make_type_info(BALL), free);
   body_set_velocity(ball, velocity);
 
   return ball;
@@ -186,10 +167,9 @@ void add_pegs(scene_t *scene) {
   // Add N_ROWS and N_COLS of pegs.
   for (size_t i = 1; i <= N_ROWS; i++) {
     for (size_t j = 0; j <= i; j++) {
-      list_t *polygon = circle_init(PEG_RADIUS);
-      body_t *body = body_init_with_info(polygon, INFINITY, PEG_COLOR,
-                                         make_type_info(WALL), free);
-      body_set_centroid(body, get_peg_center(i, j));
+      body_t *body =
+          body_init_circle(get_peg_center(i, j), PEG_RADIUS, INFINITY,
+                           PEG_COLOR, make_type_info(WALL), free);
       scene_add_body(scene, body);
     }
   }
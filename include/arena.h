@@ -0,0 +1,62 @@
+#ifndef __ARENA_H__
+#define __ARENA_H__
+
+#include <stddef.h>
+
+/**
+ * A bump allocator for short-lived scratch memory.
+ * Allocations are carved out of one growable block and are never freed
+ * individually; instead, arena_reset() releases all of them at once.
+ * Once the block has grown to fit a typical frame's worth of allocations,
+ * allocating from the arena no longer calls malloc() or free().
+ */
+typedef struct arena arena_t;
+
+/**
+ * Allocates memory for a new, empty arena.
+ * Asserts that the required memory was allocated.
+ *
+ * @param initial_size the number of bytes to allocate space for
+ * @return a pointer to the newly allocated arena
+ */
+arena_t *arena_init(size_t initial_size);
+
+/**
+ * Releases the memory allocated for an arena,
+ * including every allocation made from it.
+ *
+ * @param arena a pointer to an arena returned from arena_init()
+ */
+void arena_free(arena_t *arena);
+
+/**
+ * Allocates memory from an arena.
+ * The memory is suitably aligned for any type and stays valid until the
+ * next call to arena_reset(); it must not be passed to free().
+ * If the arena is full, it moves on to a larger block and asserts that the
+ * block was allocated.
+ *
+ * @param arena a pointer to an arena returned from arena_init()
+ * @param size the number of bytes to allocate
+ * @return a pointer to the allocated memory
+ */
+void *arena_alloc(arena_t *arena, size_t size);
+
+/**
+ * Releases every allocation made from an arena since the last reset.
+ * If the arena outgrew its block, the outgrown blocks are freed now,
+ * so the arena keeps a single block large enough for all of them.
+ *
+ * @param arena a pointer to an arena returned from arena_init()
+ */
+void arena_reset(arena_t *arena);
+
+/**
+ * Gets the number of bytes allocated from an arena since the last reset.
+ *
+ * @param arena a pointer to an arena returned from arena_init()
+ * @return the number of bytes in use, including alignment padding
+ */
+size_t arena_used(arena_t *arena);
+
+#endif // #ifndef __ARENA_H__
@@ -0,0 +1,17 @@
+#ifndef __BIKE_H__
+#define __BIKE_H__
+
+#include "list.h"
+
+/**
+ * Builds the outline of the motorbike (wheels, frame, and rider) out of
+ * line segments and sampled curves.
+ * The shape is centered near the origin, roughly 13 units wide and
+ * 8 units tall, so it is normally scaled up before being used for a body.
+ *
+ * @return a newly allocated list of vector_t pointers, in counterclockwise
+ * order, with about 500 vertices
+ */
+list_t *make_bike_shape();
+
+#endif // #ifndef __BIKE_H__
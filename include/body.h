@@ -1,8 +1,11 @@
 #ifndef __BODY_H__
 #define __BODY_H__
 
+#include "chain.h"
 #include "color.h"
+#include "heightfield.h"
 #include "list.h"
+#include "polygon.h"
 #include "vector.h"
 #include <stdbool.h>
 
@@ -14,6 +17,20 @@
  */
 typedef struct body body_t;
 
+/**
+ * How a body takes part in the simulation.
+ * Dynamic bodies respond to forces and impulses and are integrated every tick.
+ * Kinematic bodies have infinite mass: they ignore forces and impulses
+ * but still move with their velocity and angular velocity.
+ * Static bodies never move on their own; scene_tick() skips them entirely.
+ * Kinematic and static bodies can still be moved with body_set_centroid().
+ */
+typedef enum {
+  MOTION_DYNAMIC,
+  MOTION_KINEMATIC,
+  MOTION_STATIC
+} motion_type_t;
+
 /**
  * Initializes a body without any info.
  * Acts like body_init_with_info() where info and info_freer are NULL.
@@ -25,7 +42,9 @@ body_t *body_init(list_t *shape, double mass, rgb_color_t color);
  * The body is initially at rest.
  * Asserts that the mass is positive and that the required memory is allocated.
  *
- * @param shape a list of vectors describing the initial shape of the body
+ * @param shape a list of vectors describing the initial shape of the body.
+ *   The vertices are copied into the body's contiguous polygon storage
+ *   and the list is freed.
  * @param mass the mass of the body (if INFINITY, stops the body from moving)
  * @param color the color of the body, used to draw it on the screen
  * @param info additional information to associate with the body,
@@ -36,6 +55,221 @@ body_t *body_init(list_t *shape, double mass, rgb_color_t color);
 body_t *body_init_with_info(list_t *shape, double mass, rgb_color_t color,
                             void *info, free_func_t info_freer);
 
+/**
+ * Allocates a body from an arena, such as a scene's (see
+ * scene_get_body_arena()). The body, its polygons and the convex parts and
+ * normals it finds for collisions live in the arena, so releasing the arena
+ * releases them all at once. body_free() still frees the body's info,
+ * heightfield and list of forces, but not the arena's memory.
+ * Memory for shapes the body rebuilds stays in use until the arena is
+ * released, so bodies whose shapes keep changing belong on the heap.
+ * If arena is NULL, this is the same as body_init_with_info().
+ * See body_init_with_info() for the other parameters.
+ *
+ * @param arena a pointer to an arena returned from arena_init(), or NULL
+ * @return a pointer to the body in the arena
+ */
+body_t *body_init_with_info_in(arena_t *arena, list_t *shape, double mass,
+                               rgb_color_t color, void *info,
+                               free_func_t info_freer);
+
+/**
+ * Initializes a static body without any info.
+ * Acts like body_init_static_with_info() where info and info_freer are NULL.
+ */
+body_t *body_init_static(list_t *shape, rgb_color_t color);
+
+/**
+ * Allocates memory for a static body, such as a piece of the ground.
+ * The body has infinite mass and is never integrated, so it only moves
+ * when body_set_centroid() or body_set_rotation() is called on it.
+ * See body_init_with_info() for the parameters.
+ *
+ * @return a pointer to the newly allocated body
+ */
+body_t *body_init_static_with_info(list_t *shape, rgb_color_t color,
+                                   void *info, free_func_t info_freer);
+
+/**
+ * Allocates memory for a static body shaped like a heightfield, such as
+ * a stretch of terrain. The body is drawn as the heightfield's outline and
+ * its convex parts are the heightfield's columns, so a collision test only
+ * looks at the few columns under the other body (see body_find_parts()).
+ * See body_init_with_info() for the other parameters.
+ *
+ * @param heightfield a heightfield in world coordinates, which the body
+ *   takes ownership of and frees along with itself
+ * @return a pointer to the newly allocated body
+ */
+body_t *body_init_heightfield(heightfield_t *heightfield, rgb_color_t color,
+                              void *info, free_func_t info_freer);
+
+/**
+ * Allocates a heightfield body from an arena.
+ * See body_init_heightfield() and body_init_with_info_in().
+ *
+ * @param arena a pointer to an arena returned from arena_init(), or NULL
+ * @return a pointer to the body in the arena
+ */
+body_t *body_init_heightfield_in(arena_t *arena, heightfield_t *heightfield,
+                                 rgb_color_t color, void *info,
+                                 free_func_t info_freer);
+
+/**
+ * Allocates memory for a static body that collides as a chain of one-sided
+ * segments, such as a whole level's terrain with loops and overhangs.
+ * The body is drawn as the polygon through the chain's vertices.
+ * Collisions with it find the segments near each convex part of the other
+ * body with the chain's hierarchy, and push the part out along a segment's
+ * normal, or a vertex's where the part reaches past the segment's ends
+ * (see chain_get_vertex_normal()). Two chain bodies never collide.
+ * See body_init_with_info() for the other parameters.
+ *
+ * @param chain a chain in world coordinates, which the body takes ownership
+ *   of and frees along with itself
+ * @return a pointer to the newly allocated body
+ */
+body_t *body_init_chain(chain_t *chain, rgb_color_t color, void *info,
+                        free_func_t info_freer);
+
+/**
+ * Gets the chain a body collides as.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return the chain passed to body_init_chain(), in the coordinates it was
+ *   given in, or NULL if the body was not made with body_init_chain()
+ */
+const chain_t *body_get_chain(body_t *body);
+
+/**
+ * Converts a point from the coordinates a body's heightfield or chain was
+ * given in to world coordinates, following the body's moves and turns since.
+ *
+ * @param body a pointer to a body returned from body_init_heightfield() or
+ *   body_init_chain()
+ * @param point a point in the heightfield's or chain's coordinates
+ * @return the point in world coordinates
+ */
+vector_t body_shape_to_world(body_t *body, vector_t point);
+
+/**
+ * Converts a point from world coordinates to those a body's heightfield or
+ * chain was given in. The inverse of body_shape_to_world().
+ *
+ * @param body a pointer to a body returned from body_init_heightfield() or
+ *   body_init_chain()
+ * @param point a point in world coordinates
+ * @return the point in the heightfield's or chain's coordinates
+ */
+vector_t body_world_to_shape(body_t *body, vector_t point);
+
+/**
+ * Allocates memory for a dynamic body shaped like a circle, such as a ball
+ * or a wheel. Collisions with it use the circle itself, so testing it
+ * against another circle takes O(1) time and against a polygon O(n) in the
+ * polygon's vertices (see find_body_collision()). The body's polygon (see
+ * body_get_polygon()) is a regular polygon through points on the circle,
+ * and is only used where an outline is needed.
+ * The body's moment of inertia is that of a uniform disc, m r^2 / 2.
+ * See body_init_with_info() for the other parameters.
+ *
+ * @param center the center of the circle, which is the body's centroid
+ * @param radius the radius of the circle; asserted to be positive
+ * @param mass the mass of the body (if INFINITY, stops the body from moving)
+ * @return a pointer to the newly allocated body
+ */
+body_t *body_init_circle(vector_t center, double radius, double mass,
+                         rgb_color_t color, void *info,
+                         free_func_t info_freer);
+
+/**
+ * Checks whether a body collides as a circle. See body_init_circle().
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return whether the body was created with body_init_circle() and has not
+ *   been given a polygon since
+ */
+bool body_is_circle(body_t *body);
+
+/**
+ * Gets the radius of a circle body. See body_init_circle().
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return the circle's radius, or 0 if the body is not a circle
+ */
+double body_get_radius(body_t *body);
+
+/**
+ * Allocates memory for a kinematic body without any info.
+ * The body has infinite mass, so forces and impulses have no effect on it,
+ * but it moves according to its velocity and angular velocity.
+ * See body_init_with_info() for the parameters.
+ *
+ * @return a pointer to the newly allocated body
+ */
+body_t *body_init_kinematic(list_t *shape, rgb_color_t color);
+
+/**
+ * Allocates memory for a decoration: a static body that is drawn along with
+ * the rest of the scene but never takes part in the simulation.
+ * Decorations keep their place in the scene's body order, so they are drawn
+ * in the order they were added, but they are never ticked and cannot have
+ * force creators attached to them. Use them for purely visual layers such as
+ * backgrounds and menu buttons.
+ *
+ * @param shape a list of vectors describing the shape of the body.
+ *   The vertices are copied into the body and the list is freed.
+ * @param color the color of the body, used to draw it on the screen
+ * @return a pointer to the newly allocated body
+ */
+body_t *body_init_decoration(list_t *shape, rgb_color_t color);
+
+/**
+ * Allocates a decoration from an arena.
+ * See body_init_decoration() and body_init_with_info_in().
+ *
+ * @param arena a pointer to an arena returned from arena_init(), or NULL
+ * @return a pointer to the decoration in the arena
+ */
+body_t *body_init_decoration_in(arena_t *arena, list_t *shape,
+                                rgb_color_t color);
+
+/**
+ * Checks whether a body is render-only. See body_init_decoration().
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return whether the body was created with body_init_decoration()
+ */
+bool body_is_decoration(body_t *body);
+
+/**
+ * Marks a body as a bullet, or not. When a bullet moves by more than half
+ * its own width in one scene tick, the scene sweeps it along the step and
+ * stops it at the first body it has a contact force creator with, so it
+ * can't tunnel through thin bodies on a long tick.
+ * See scene_tick().
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @param bullet whether the body should be swept
+ */
+void body_set_bullet(body_t *body, bool bullet);
+
+/**
+ * Checks whether a body is a bullet. See body_set_bullet().
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return whether the body is a bullet
+ */
+bool body_is_bullet(body_t *body);
+
+/**
+ * Gets how a body takes part in the simulation.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return whether the body is dynamic, kinematic, or static
+ */
+motion_type_t body_get_motion_type(body_t *body);
+
 /**
  * Releases the memory allocated for a body.
  *
@@ -52,6 +286,150 @@ void body_free(body_t *body);
  */
 list_t *body_get_shape(body_t *body);
 
+/**
+ * Gets a read-only view of the current shape of a body without copying it.
+ * The polygon is owned by the body and must not be modified or freed.
+ * It is only guaranteed to be valid until the body is next moved, rotated,
+ * given a new polygon, or freed; use body_get_shape() to keep a copy.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return the polygon describing the body's current position
+ */
+const polygon_t *body_get_polygon(body_t *body);
+
+/**
+ * Gets the distinct unit edge normals of a body's current shape, as computed
+ * by polygon_get_normals(). They are computed once in the body's local frame
+ * and only rotated again after the body turns.
+ * The polygon is owned by the body and must not be modified or freed.
+ * It is only guaranteed to be valid until the body is next rotated,
+ * given a new polygon, or freed.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return a polygon holding one world-space unit normal per edge direction
+ */
+const polygon_t *body_get_normals(body_t *body);
+
+/**
+ * Makes a body collide as a simplified copy of its shape, while
+ * body_get_polygon() keeps returning the full-detail outline for drawing.
+ * The copy is built with polygon_simplify() on the next collision query,
+ * and rebuilt on the first query after the body is given a new polygon.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @param tolerance how far the collision shape may deviate from the
+ * outline, or 0 to collide with the outline itself
+ */
+void body_set_collision_tolerance(body_t *body, double tolerance);
+
+/**
+ * Gets the number of convex parts a body's collision shape is split into.
+ * Concave shapes are decomposed (see polygon_decompose()) on the first
+ * collision query, and again on the first query after the body is given a
+ * new polygon or collision tolerance; convex shapes are 1 part.
+ * A heightfield body has one part per column, and a chain body is 1 part,
+ * its outline, which collisions don't use.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return the number of convex parts, at least 1
+ */
+size_t body_get_num_parts(body_t *body);
+
+/**
+ * Gets a convex part of a body's current collision shape. For a convex body
+ * without a collision tolerance, part 0 is the whole shape, as returned by
+ * body_get_polygon().
+ * The same ownership and lifetime rules as body_get_polygon() apply.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @param index the index of the part, less than body_get_num_parts()
+ * @return the polygon of the part in its current position
+ */
+const polygon_t *body_get_part(body_t *body, size_t index);
+
+/**
+ * Finds the convex parts of a body that might overlap a box.
+ * For a body made with body_init_heightfield() that has not been rotated,
+ * these are the columns under the box, found in O(log n).
+ * For any other body, they are all of its parts.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @param bounds the box to look under, e.g. another body's bounds
+ * @param first where to store the index of the first part to test
+ * @param end where to store one past the index of the last part to test
+ */
+void body_find_parts(body_t *body, aabb_t bounds, size_t *first,
+                     size_t *end);
+
+/**
+ * Gets the distinct unit edge normals of a convex part of a body, as
+ * body_get_normals() does for the whole shape.
+ * The same ownership and lifetime rules as body_get_normals() apply.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @param index the index of the part, less than body_get_num_parts()
+ * @return a polygon holding one world-space unit normal per edge direction
+ */
+const polygon_t *body_get_part_normals(body_t *body, size_t index);
+
+/**
+ * Gets the vertices of a convex part of a body that project furthest back
+ * and forward along each of the part's normals (see polygon_get_extremes()).
+ * These don't change as the body moves and turns, so they are found once,
+ * and a separating axis test starts its search for the part's extremes
+ * along one of its own normals from the answer.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @param index the index of the part, less than body_get_num_parts()
+ * @return 2 vertex indices into body_get_part() for each normal in
+ *   body_get_part_normals(): the smallest and then the largest projection.
+ *   The array is owned by the body and changes with its shape.
+ */
+const size_t *body_get_part_extremes(body_t *body, size_t index);
+
+/**
+ * Gets an axis-aligned box that contains the body's shape.
+ * The box is updated in O(1) whenever the body moves or rotates. It is exact
+ * while the body is unrotated and may be slightly larger than the shape
+ * otherwise.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return a bounding box of the body's current shape
+ */
+aabb_t body_get_bounds(body_t *body);
+
+/**
+ * Gets the center of a circle that contains the body's shape.
+ * This is the body's initial centroid, carried along as the body moves,
+ * so it can drift away from body_get_centroid() when the body rotates
+ * about a pivot (see body_rotate()).
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return the center of the body's bounding circle
+ */
+vector_t body_get_bounding_center(body_t *body);
+
+/**
+ * Gets the radius of a circle around body_get_bounding_center()
+ * that contains the body's shape.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return the radius of the body's bounding circle
+ */
+double body_get_bounding_radius(body_t *body);
+
+/**
+ * Gets a counter that changes whenever the body's shape in the world changes,
+ * i.e. whenever it is moved, rotated, or given a new polygon or collision
+ * tolerance.
+ * Results computed from the body's shape can be reused for as long as
+ * this value stays the same.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return the version of the body's world-space shape
+ */
+size_t body_get_shape_version(body_t *body);
+
 /**
  * Gets the current center of mass of a body.
  * While this could be calculated with polygon_centroid(), that becomes too slow
@@ -102,6 +480,36 @@ rgb_color_t body_get_color(body_t *body);
  */
 void *body_get_info(body_t *body);
 
+/**
+ * Gets the force creators that act on a body.
+ * A scene keeps this list up to date as force creators are added and
+ * removed, so it can reap a removed body's force creators directly.
+ * The list does not own its elements and should not be modified elsewhere.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return the list of the scene's force creators involving the body
+ */
+list_t *body_get_forces(body_t *body);
+
+/**
+ * Gets the index a scene last stored with body_set_proxy_index().
+ * The scene checks that its broadphase proxy at that index is still this
+ * body's before using it, so a stale index is harmless.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return the stored index, or 0 if none was stored
+ */
+size_t body_get_proxy_index(body_t *body);
+
+/**
+ * Stores the index of a body's broadphase proxy in its scene, so the scene
+ * can find the proxy in O(1).
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @param index the index of the body's proxy
+ */
+void body_set_proxy_index(body_t *body, size_t index);
+
 /**
  * Translates a body to a new position.
  * The position is specified by the position of the body's center of mass.
@@ -137,6 +545,13 @@ void body_set_acceleration(body_t *body, vector_t a);
  */
 void body_set_rotation(body_t *body, double angle);
 
+/**
+ * Rotates a body by a relative angle about its current pivot
+ * (see body_set_pivot()). The stored centroid is not moved.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @param angle the angle to rotate by in radians. Positive is counterclockwise.
+ */
 void body_rotate(body_t *body, double angle);
 
 double body_get_rotation(body_t *body);
@@ -145,6 +560,7 @@ double body_get_rotation(body_t *body);
  * Applies a force to a body over the current tick.
  * If multiple forces are applied in the same tick, they should be added.
  * Should not change the body's position or velocity; see body_tick().
+ * Has no effect on kinematic and static bodies.
  *
  * @param body a pointer to a body returned from body_init()
  * @param force the force vector to apply
@@ -159,6 +575,7 @@ vector_t body_get_force(body_t *body);
  * which is useful for modeling collisions.
  * If multiple impulses are applied in the same tick, they should be added.
  * Should not change the body's position or velocity; see body_tick().
+ * Has no effect on kinematic and static bodies.
  *
  * @param body a pointer to a body returned from body_init()
  * @param impulse the impulse vector to apply
@@ -263,6 +680,8 @@ void body_reset_pivot(body_t *body);
  * The body should be translated at the *average* of the velocities before
  * and after the tick.
  * Resets the forces and impulses accumulated on the body.
+ * Kinematic bodies only move with their current velocities,
+ * and static bodies are left untouched.
  *
  * @param body the body to tick
  * @param dt the number of seconds elapsed since the last tick
@@ -290,6 +709,10 @@ bool body_is_removed(body_t *body);
 
 /**
  * Sets the polygon field of a body
+ * The vertices are copied into the body and the list is freed.
+ * A body made with body_init_heightfield() or body_init_chain() frees its
+ * heightfield or chain, and one made with body_init_circle() stops being a
+ * circle; either way it collides as the new polygon from then on.
  *
  * @param body a pointer to the body to update
  * @param polygon the polygon to set field to
@@ -0,0 +1,120 @@
+#ifndef __CHAIN_H__
+#define __CHAIN_H__
+
+#include "list.h"
+#include "polygon.h"
+#include "vector.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * Static geometry made of line segments joined end to end, such as level
+ * terrain with loops and overhangs that a heightfield can't describe.
+ * Segment i runs from vertex i to vertex i + 1, and a closed chain has one
+ * more segment from its last vertex back to its first.
+ *
+ * Segments are one-sided: each only collides with shapes on its left,
+ * looking from its start to its end. Ground listed left to right faces up,
+ * and a loop listed clockwise faces outwards.
+ *
+ * A chain keeps a bounding volume hierarchy over its segments, so finding
+ * the segments near a box takes O(log n) time for a small box.
+ */
+typedef struct chain chain_t;
+
+/**
+ * Called by chain_query() with the index of each segment it finds.
+ */
+typedef void (*chain_visitor_t)(size_t segment, void *aux);
+
+/**
+ * Allocates memory for a chain and builds its hierarchy.
+ * Asserts that there are at least 2 vertices (3 if the chain is closed)
+ * and that no segment has zero length.
+ *
+ * @param vertices a list of vector_t* giving the chain's vertices in order.
+ *   The vertices are copied and the list is freed.
+ * @param closed whether the last vertex is joined back to the first
+ * @return a pointer to the newly allocated chain
+ */
+chain_t *chain_init(list_t *vertices, bool closed);
+
+/**
+ * Releases the memory allocated for a chain.
+ *
+ * @param chain a pointer to a chain returned from chain_init()
+ */
+void chain_free(chain_t *chain);
+
+/**
+ * Gets the number of segments in a chain.
+ *
+ * @param chain a pointer to a chain returned from chain_init()
+ * @return the number of segments
+ */
+size_t chain_num_segments(const chain_t *chain);
+
+/**
+ * Gets the box around all of a chain's vertices.
+ *
+ * @param chain a pointer to a chain returned from chain_init()
+ * @return the chain's bounding box
+ */
+aabb_t chain_get_bounds(const chain_t *chain);
+
+/**
+ * Gets the endpoints of a segment.
+ *
+ * @param chain a pointer to a chain returned from chain_init()
+ * @param index the index of the segment, less than chain_num_segments()
+ * @param start where to store the segment's first vertex
+ * @param end where to store the segment's second vertex
+ */
+void chain_get_segment(const chain_t *chain, size_t index, vector_t *start,
+                       vector_t *end);
+
+/**
+ * Gets the unit normal of a segment's colliding side.
+ *
+ * @param chain a pointer to a chain returned from chain_init()
+ * @param index the index of the segment, less than chain_num_segments()
+ * @return the unit vector perpendicular to the segment, pointing left
+ */
+vector_t chain_get_segment_normal(const chain_t *chain, size_t index);
+
+/**
+ * Gets the normal of a chain at a vertex: the average of the normals of
+ * the segments that share it. A shape that touches a segment beyond its
+ * ends is pushed out along these instead of the segment's own normal, so
+ * normals turn smoothly across each vertex rather than catching on seams.
+ *
+ * @param chain a pointer to a chain returned from chain_init()
+ * @param index the index of the vertex (the first is at 0). As segment i
+ *   ends at vertex i + 1, an index one past the last vertex is the first.
+ * @return a unit normal on the colliding side of the segments at the vertex
+ */
+vector_t chain_get_vertex_normal(const chain_t *chain, size_t index);
+
+/**
+ * Finds the segments whose bounding boxes overlap a box, using the chain's
+ * bounding volume hierarchy.
+ *
+ * @param chain a pointer to a chain returned from chain_init()
+ * @param box the box to search
+ * @param visitor a function called with the index of each segment found,
+ *   in no particular order
+ * @param aux an argument passed to each call of visitor
+ */
+void chain_query(const chain_t *chain, aabb_t box, chain_visitor_t visitor,
+                 void *aux);
+
+/**
+ * Builds a polygon through the vertices of a chain, e.g. to draw it.
+ *
+ * @param chain a pointer to a chain returned from chain_init()
+ * @return a newly allocated polygon_t with the chain's vertices in order,
+ *   which must be polygon_free()d
+ */
+polygon_t *chain_get_outline(const chain_t *chain);
+
+#endif // #ifndef __CHAIN_H__
@@ -1,7 +1,10 @@
 #ifndef __COLLISION_H__
 #define __COLLISION_H__
 
+#include "body.h"
 #include "list.h"
+#include "polygon.h"
+#include "pool.h"
 #include "vector.h"
 #include <stdbool.h>
 
@@ -19,8 +22,89 @@ typedef struct {
    * If collided is false, this value is undefined.
    */
   vector_t axis;
+  /**
+   * If the shapes are colliding, how far they overlap along the axis.
+   */
+  double depth;
+  /**
+   * If the shapes are colliding, the number of contact points (1 or 2).
+   */
+  size_t num_contacts;
+  /**
+   * If the shapes are colliding, the points of one shape that lie inside
+   * the other, found by clipping the edge of one shape that faces the other
+   * against the facing edge of the other. The deepest point comes first.
+   */
+  vector_t contacts[2];
 } collision_info_t;
 
+/**
+ * Finds the point of a convex shape furthest along a direction.
+ *
+ * @param shape the shape, in whatever form the function expects
+ * @param direction the direction to search in; it need not be normalized
+ * @return a point of the shape with the largest dot product with direction
+ */
+typedef vector_t (*support_func_t)(const void *shape, vector_t direction);
+
+/**
+ * A convex shape given by its support function: a core shape grown by a
+ * radius, i.e. every point within the radius of the core. A point grown
+ * this way is a circle, a segment is a capsule and a polygon is a polygon
+ * with rounded corners. See support_polygon(), support_point() and
+ * support_segment().
+ */
+typedef struct {
+  /** The support function of the core shape */
+  support_func_t support;
+  /** The core shape, which is passed to support */
+  const void *shape;
+  /** How far the shape reaches beyond its core, at least 0 */
+  double radius;
+} support_shape_t;
+
+/**
+ * A line segment, the core of a capsule.
+ */
+typedef struct {
+  vector_t start;
+  vector_t end;
+} segment_t;
+
+/**
+ * How far apart two convex shapes are, or how deeply they overlap.
+ */
+typedef struct {
+  /** Whether the shapes overlap or touch */
+  bool collided;
+  /**
+   * The distance between the shapes if they are apart, or minus how far
+   * they overlap along axis if they collide
+   */
+  double distance;
+  /**
+   * A unit vector pointing from the first shape towards the second. Moving
+   * the second shape along it by -distance makes the shapes just touch.
+   */
+  vector_t axis;
+  /**
+   * The closest points of the two shapes if they are apart. If they
+   * collide, the point of each shape deepest inside the other.
+   */
+  vector_t point1;
+  vector_t point2;
+} distance_info_t;
+
+/**
+ * Counts how often contact_get_collision()'s separating axis cache is used.
+ */
+typedef struct {
+  /** Collision tests that had a cached axis to try first */
+  size_t lookups;
+  /** Lookups where the cached axis alone showed the bodies apart */
+  size_t hits;
+} axis_cache_stats_t;
+
 /**
  * Computes the status of the collision between two convex polygons.
  * The shapes are given as lists of vertices in counterclockwise order.
@@ -29,9 +113,208 @@ typedef struct {
  *
  * @param shape1 the first shape
  * @param shape2 the second shape
- * @return whether the shapes are colliding, and if so, the collision axis.
+ * @return whether the shapes are colliding, and if so, the collision axis,
+ * penetration depth and contact points.
  * The axis should be a unit vector pointing from shape1 towards shape2.
  */
 collision_info_t find_collision(list_t *shape1, list_t *shape2);
 
+/**
+ * Computes the status of the collision between two convex polygons
+ * stored in contiguous vertex buffers. See find_collision().
+ * Polygons whose cached bounding boxes do not overlap are rejected
+ * without running the separating axis test.
+ *
+ * @param shape1 the first shape
+ * @param shape2 the second shape
+ * @return whether the shapes are colliding, and if so, the collision axis.
+ */
+collision_info_t find_polygon_collision(const polygon_t *shape1,
+                                        const polygon_t *shape2);
+
+/**
+ * Computes the status of the collision between the shapes of two bodies.
+ * Pairs whose bounding boxes or bounding circles do not overlap are
+ * rejected in O(1), without computing or reading their vertices.
+ * Concave bodies are tested as their convex parts (see body_get_part()),
+ * which is exact where plain SAT on the outline is not; the deepest
+ * overlapping pair of parts gives the axis. The candidate axes are the
+ * parts' cached unit edge normals, so the returned axis is a unit vector.
+ * A body made with body_init_chain() is instead tested segment by segment,
+ * and the axis is the chain's normal at the contact, pointing away from the
+ * chain (see body_init_chain()).
+ * A body made with body_init_circle() is tested as its circle: against
+ * another circle by comparing the distance between their centers with the
+ * sum of their radii, and against a convex part by finding the part's point
+ * closest to the center. The axis then runs through that point.
+ * See find_collision().
+ *
+ * @param body1 the first body
+ * @param body2 the second body
+ * @return whether the bodies are colliding, and if so, the collision axis.
+ */
+collision_info_t find_body_collision(body_t *body1, body_t *body2);
+
+/**
+ * Makes a support shape out of a convex polygon.
+ *
+ * @param polygon a convex polygon, which must outlive the support shape
+ * @param radius how far to grow the polygon, or 0 for the polygon itself
+ * @return the support shape
+ */
+support_shape_t support_polygon(const polygon_t *polygon, double radius);
+
+/**
+ * Makes a support shape out of a point, i.e. a circle.
+ *
+ * @param point the center, which must outlive the support shape
+ * @param radius the radius of the circle
+ * @return the support shape
+ */
+support_shape_t support_point(const vector_t *point, double radius);
+
+/**
+ * Makes a support shape out of a segment, i.e. a capsule.
+ *
+ * @param segment the segment, which must outlive the support shape
+ * @param radius the radius of the capsule's ends
+ * @return the support shape
+ */
+support_shape_t support_segment(const segment_t *segment, double radius);
+
+/**
+ * Computes the distance between two convex shapes, or their penetration
+ * depth if they overlap. The Gilbert-Johnson-Keerthi (GJK) algorithm finds
+ * the point of the shapes' cores' Minkowski difference closest to the
+ * origin, which gives the distance between the cores; the radii are then
+ * taken off. If the cores themselves overlap, the expanding polytope
+ * algorithm (EPA) grows GJK's final triangle out to the edge of the
+ * difference nearest the origin, which gives the penetration depth.
+ * Each iteration costs one call to each shape's support function, so for
+ * polygons the cost depends on the number of iterations rather than on
+ * testing every edge normal as the separating axis test does.
+ *
+ * @param shape1 the first shape
+ * @param shape2 the second shape
+ * @return whether the shapes collide, their signed distance, the axis
+ *   between them and their closest or deepest points
+ */
+distance_info_t find_convex_distance(support_shape_t shape1,
+                                     support_shape_t shape2);
+
+/**
+ * Computes the distance between the shapes of two bodies with
+ * find_convex_distance(): the smallest distance between any of their
+ * convex parts (see body_get_part()), or the largest overlap if they
+ * collide. A body made with body_init_circle() is tested as its circle.
+ * Only parts whose bounding boxes are within max_distance of each other are
+ * tested, so a small max_distance makes this a cheap proximity query.
+ * Asserts that neither body was made with body_init_chain().
+ *
+ * @param body1 the first body
+ * @param body2 the second body
+ * @param max_distance the largest distance of interest
+ * @return see find_convex_distance(); if the bodies are further apart than
+ *   max_distance, collided is false and distance is INFINITY
+ */
+distance_info_t find_body_distance(body_t *body1, body_t *body2,
+                                   double max_distance);
+
+/**
+ * A cached collision test between an ordered pair of bodies.
+ * Several force creators acting on the same pair can share one contact,
+ * so the narrowphase only runs once for each pose of the two bodies.
+ * A contact is reference counted; see contact_retain() and contact_free().
+ */
+typedef struct contact contact_t;
+
+/**
+ * Allocates a contact between two bodies, with one reference.
+ * The contact does not own the bodies.
+ *
+ * @param body1 the first body
+ * @param body2 the second body
+ * @return a pointer to the newly allocated contact
+ */
+contact_t *contact_init(body_t *body1, body_t *body2);
+
+/**
+ * Allocates a contact between two bodies from a pool. See contact_init().
+ * The contact returns its record to the pool when it is freed.
+ * Asserts that the pool's records are large enough to hold a contact.
+ *
+ * @param pool a pointer to a pool returned from pool_init()
+ * @param body1 the first body
+ * @param body2 the second body
+ * @return a pointer to the newly allocated contact
+ */
+contact_t *contact_init_in(pool_t *pool, body_t *body1, body_t *body2);
+
+/**
+ * Gets the number of bytes a pool's records need to hold a contact,
+ * for sizing a pool passed to contact_init_in().
+ *
+ * @return the size of a contact record
+ */
+size_t contact_record_size(void);
+
+/**
+ * Adds a reference to a contact.
+ *
+ * @param contact a pointer to a contact returned from contact_init()
+ * @return the same contact
+ */
+contact_t *contact_retain(contact_t *contact);
+
+/**
+ * Drops a reference to a contact, freeing it when no references remain.
+ *
+ * @param contact a pointer to a contact returned from contact_init()
+ */
+void contact_free(contact_t *contact);
+
+/**
+ * Gets the first body of a contact.
+ *
+ * @param contact a pointer to a contact returned from contact_init()
+ * @return the body passed as body1 to contact_init()
+ */
+body_t *contact_get_body1(contact_t *contact);
+
+/**
+ * Gets the second body of a contact.
+ *
+ * @param contact a pointer to a contact returned from contact_init()
+ * @return the body passed as body2 to contact_init()
+ */
+body_t *contact_get_body2(contact_t *contact);
+
+/**
+ * Computes the status of the collision between a contact's bodies,
+ * as find_body_collision() would.
+ * The result is cached, and only recomputed once either body's
+ * shape has changed (see body_get_shape_version()).
+ * The contact also remembers the last axis that separated its bodies and
+ * tries it before the full separating axis test, since a pair that was apart
+ * on the last tick is usually still apart along the same axis.
+ *
+ * @param contact a pointer to a contact returned from contact_init()
+ * @return whether the bodies are colliding, and if so, the collision axis.
+ */
+collision_info_t contact_get_collision(contact_t *contact);
+
+/**
+ * Gets the counters of the separating axis cache kept by contacts,
+ * summed over every contact since the program started or the counters
+ * were last reset.
+ *
+ * @return the number of cache lookups and hits
+ */
+axis_cache_stats_t collision_get_axis_cache_stats(void);
+
+/**
+ * Resets the counters returned by collision_get_axis_cache_stats() to 0.
+ */
+void collision_reset_axis_cache_stats(void);
+
 #endif // #ifndef __COLLISION_H__
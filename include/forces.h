@@ -14,7 +14,15 @@
 typedef void (*collision_handler_t)(body_t *body1, body_t *body2, vector_t axis,
                                     void *aux);
 
-void create_applied(scene_t *scene, vector_t force, body_t *body);
+/**
+ * Gets the number of bytes a scene's records (see scene_alloc_record())
+ * need to hold the arguments of any force creator in this file.
+ *
+ * @return the size of the largest force creator arguments
+ */
+size_t force_arg_record_size(void);
+
+force_t *create_applied(scene_t *scene, vector_t force, body_t *body);
 
 void applied_force_creator(void *aux);
 
@@ -71,8 +79,9 @@ void create_spring(scene_t *scene, double k, body_t *body1, body_t *body2);
  * @param gamma the proportionality constant between force and velocity
  *   (higher gamma means more drag)
  * @param body the body to slow down
+ * @return a handle for removing the drag with scene_remove_force_creator()
  */
-void create_drag(scene_t *scene, double gamma, body_t *body);
+force_t *create_drag(scene_t *scene, double gamma, body_t *body);
 
 /**
  * Force creator that applies drag to bodies.
@@ -96,10 +105,12 @@ void drag_creator(void *aux);
  * @param handler a function to call whenever the bodies collide
  * @param aux an auxiliary value to pass to the handler
  * @param freer if non-NULL, a function to call in order to free aux
+ * @return the force creator, whose force_get_contact() holds the pair's
+ *   cached collision, e.g. for a handler that needs its contact points
  */
-void create_collision(scene_t *scene, body_t *body1, body_t *body2,
-                      collision_handler_t handler, void *aux,
-                      free_func_t freer);
+force_t *create_collision(scene_t *scene, body_t *body1, body_t *body2,
+                          collision_handler_t handler, void *aux,
+                          free_func_t freer);
 
 /**
  * Adds a force creator to a scene that destroys two bodies when they collide.
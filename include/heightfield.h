@@ -0,0 +1,131 @@
+#ifndef __HEIGHTFIELD_H__
+#define __HEIGHTFIELD_H__
+
+#include "list.h"
+#include "polygon.h"
+#include "vector.h"
+#include <stddef.h>
+
+/**
+ * Terrain whose surface is a function of x: a sorted run of (x, height)
+ * samples joined by straight segments, filled down to a flat base.
+ * The strip between two neighbouring samples is a column. Because the
+ * samples are sorted, the columns under any range of x are found with a
+ * binary search, so queries cost O(log n) however long the terrain is.
+ */
+typedef struct heightfield heightfield_t;
+
+/**
+ * Allocates memory for a heightfield.
+ * Asserts that there are at least 2 samples, that their x coordinates
+ * strictly increase, and that none of them is below the base.
+ *
+ * @param samples a list of vector_t* holding each sample's x and height,
+ *   sorted by x. The samples are copied and the list is freed.
+ * @param base the y coordinate of the bottom of the terrain
+ * @return a pointer to the newly allocated heightfield
+ */
+heightfield_t *heightfield_init(list_t *samples, double base);
+
+/**
+ * Releases the memory allocated for a heightfield.
+ *
+ * @param heightfield a pointer to a heightfield returned from
+ *   heightfield_init()
+ */
+void heightfield_free(heightfield_t *heightfield);
+
+/**
+ * Gets the number of columns in a heightfield, one fewer than its samples.
+ *
+ * @param heightfield a pointer to a heightfield returned from
+ *   heightfield_init()
+ * @return the number of columns
+ */
+size_t heightfield_num_columns(const heightfield_t *heightfield);
+
+/**
+ * Gets the box around a heightfield, from its base to its highest sample.
+ *
+ * @param heightfield a pointer to a heightfield returned from
+ *   heightfield_init()
+ * @return the heightfield's bounding box
+ */
+aabb_t heightfield_get_bounds(const heightfield_t *heightfield);
+
+/**
+ * Finds the columns that lie at least partly within a range of x,
+ * in O(log n). The columns are first, first + 1, ..., end - 1, so
+ * first == end if the range misses the heightfield.
+ *
+ * @param heightfield a pointer to a heightfield returned from
+ *   heightfield_init()
+ * @param min_x the left end of the range
+ * @param max_x the right end of the range
+ * @param first where to store the index of the first column in the range
+ * @param end where to store one past the index of the last column
+ */
+void heightfield_find_columns(const heightfield_t *heightfield, double min_x,
+                              double max_x, size_t *first, size_t *end);
+
+/**
+ * Computes the height of a heightfield's surface, in O(log n).
+ *
+ * @param heightfield a pointer to a heightfield returned from
+ *   heightfield_init()
+ * @param x the x coordinate to look up
+ * @return the height of the surface above x, or NAN if x is outside the
+ *   heightfield
+ */
+double heightfield_get_height(const heightfield_t *heightfield, double x);
+
+/**
+ * Builds one column of a heightfield as a convex quadrilateral.
+ *
+ * @param heightfield a pointer to a heightfield returned from
+ *   heightfield_init()
+ * @param index the index of the column (the leftmost is at 0)
+ * @return a newly allocated polygon_t listing the column's corners
+ *   clockwise from its bottom left, so its top edge runs left to right,
+ *   which must be polygon_free()d
+ */
+polygon_t *heightfield_get_column(const heightfield_t *heightfield,
+                                  size_t index);
+
+/**
+ * Builds one column of a heightfield in an arena.
+ * See heightfield_get_column() and polygon_init_in().
+ *
+ * @param arena a pointer to an arena returned from arena_init(), or NULL
+ * @param heightfield a pointer to a heightfield returned from
+ *   heightfield_init()
+ * @param index the index of the column (the leftmost is at 0)
+ * @return a polygon_t in the arena listing the column's corners
+ */
+polygon_t *heightfield_get_column_in(arena_t *arena,
+                                     const heightfield_t *heightfield,
+                                     size_t index);
+
+/**
+ * Builds the outline of a whole heightfield, e.g. to draw it.
+ *
+ * @param heightfield a pointer to a heightfield returned from
+ *   heightfield_init()
+ * @return a newly allocated polygon_t listing the bottom corners and then
+ *   the samples from right to left, which must be polygon_free()d
+ */
+polygon_t *heightfield_get_outline(const heightfield_t *heightfield);
+
+/**
+ * Builds the outline of a whole heightfield in an arena.
+ * See heightfield_get_outline() and polygon_init_in().
+ *
+ * @param arena a pointer to an arena returned from arena_init(), or NULL
+ * @param heightfield a pointer to a heightfield returned from
+ *   heightfield_init()
+ * @return a polygon_t in the arena listing the outline's vertices
+ */
+polygon_t *heightfield_get_outline_in(arena_t *arena,
+                                      const heightfield_t *heightfield);
+
+#endif // #ifndef __HEIGHTFIELD_H__
@@ -1,8 +1,29 @@
 #ifndef __POLYGON_H__
 #define __POLYGON_H__
 
+#include "arena.h"
 #include "list.h"
 #include "vector.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * A polygon whose vertices are stored contiguously.
+ * The x and y coordinates live in two separate arrays (structure of arrays),
+ * so walking the vertices touches sequential memory instead of chasing one
+ * pointer per vertex the way a list_t of vector_t* does.
+ * The polygon automatically grows its buffers when more capacity is needed.
+ */
+typedef struct polygon polygon_t;
+
+/**
+ * An axis-aligned bounding box, given by its lower-left corner (min)
+ * and upper-right corner (max).
+ */
+typedef struct {
+  vector_t min;
+  vector_t max;
+} aabb_t;
 
 /**
  * Computes the area of a polygon.
@@ -49,4 +70,362 @@ void polygon_rotate(list_t *polygon, double angle, vector_t point);
 // gets list of adjacent edges' vectors
 list_t *polygon_edges(list_t *polygon);
 
+/**
+ * Allocates memory for a new polygon with space for the given number of
+ * vertices. The polygon initially has no vertices.
+ * Asserts that the required memory was allocated.
+ *
+ * @param initial_size the number of vertices to allocate space for
+ * @return a pointer to the newly allocated polygon
+ */
+polygon_t *polygon_init(size_t initial_size);
+
+/**
+ * Allocates a new polygon from an arena, for use as scratch geometry.
+ * The polygon and its vertices stay valid until the arena is reset,
+ * and it grows within the arena when vertices are added.
+ * polygon_free() has no effect on it.
+ * If arena is NULL, this is the same as polygon_init().
+ *
+ * @param arena a pointer to an arena returned from arena_init(), or NULL
+ * @param initial_size the number of vertices to allocate space for
+ * @return a pointer to the newly allocated polygon
+ */
+polygon_t *polygon_init_in(arena_t *arena, size_t initial_size);
+
+/**
+ * Builds a polygon from a list of vertices.
+ * The list is not modified or freed.
+ *
+ * @param vertices a list of vector_t* listed in counterclockwise order
+ * @return a newly allocated polygon with the same vertices
+ */
+polygon_t *polygon_from_list(list_t *vertices);
+
+/**
+ * Builds a polygon from a list of vertices in an arena.
+ * See polygon_from_list() and polygon_init_in().
+ *
+ * @param arena a pointer to an arena returned from arena_init(), or NULL
+ * @param vertices a list of vector_t* listed in counterclockwise order
+ * @return a polygon in the arena with the same vertices
+ */
+polygon_t *polygon_from_list_in(arena_t *arena, list_t *vertices);
+
+/**
+ * Copies the vertices of a polygon into a newly allocated vector list,
+ * which must be list_free()d.
+ *
+ * @param polygon a pointer to a polygon returned from polygon_init()
+ * @return a list of vector_t* with the polygon's vertices
+ */
+list_t *polygon_to_list(const polygon_t *polygon);
+
+/**
+ * Allocates a deep copy of a polygon.
+ *
+ * @param polygon a pointer to a polygon returned from polygon_init()
+ * @return a newly allocated polygon with the same vertices
+ */
+polygon_t *polygon_copy(const polygon_t *polygon);
+
+/**
+ * Copies a polygon into an arena. See polygon_init_in().
+ *
+ * @param arena a pointer to an arena returned from arena_init(), or NULL
+ * @param polygon a pointer to a polygon returned from polygon_init()
+ * @return a polygon in the arena with the same vertices
+ */
+polygon_t *polygon_copy_in(arena_t *arena, const polygon_t *polygon);
+
+/**
+ * Releases the memory allocated for a polygon.
+ *
+ * @param polygon a pointer to a polygon returned from polygon_init()
+ */
+void polygon_free(polygon_t *polygon);
+
+/**
+ * Gets the number of vertices in a polygon.
+ *
+ * @param polygon a pointer to a polygon returned from polygon_init()
+ * @return the number of vertices
+ */
+size_t polygon_size(const polygon_t *polygon);
+
+/**
+ * Gets the vertex at a given index in a polygon.
+ * Asserts that the index is valid.
+ *
+ * @param polygon a pointer to a polygon returned from polygon_init()
+ * @param index an index in the polygon (the first vertex is at 0)
+ * @return the vertex at the given index
+ */
+vector_t polygon_get_vertex(const polygon_t *polygon, size_t index);
+
+/**
+ * Overwrites the vertex at a given index in a polygon.
+ * Asserts that the index is valid.
+ *
+ * @param polygon a pointer to a polygon returned from polygon_init()
+ * @param index an index in the polygon (the first vertex is at 0)
+ * @param vertex the new position of the vertex
+ */
+void polygon_set_vertex(polygon_t *polygon, size_t index, vector_t vertex);
+
+/**
+ * Appends a vertex to the end of a polygon, growing it if necessary.
+ *
+ * @param polygon a pointer to a polygon returned from polygon_init()
+ * @param vertex the vertex to add
+ */
+void polygon_add_vertex(polygon_t *polygon, vector_t vertex);
+
+/**
+ * Gets the contiguous array of vertex x coordinates.
+ * The array has polygon_size() elements and is invalidated by any call
+ * that adds vertices to the polygon.
+ *
+ * @param polygon a pointer to a polygon returned from polygon_init()
+ * @return the x coordinates of the vertices
+ */
+const double *polygon_get_xs(const polygon_t *polygon);
+
+/**
+ * Gets the contiguous array of vertex y coordinates.
+ * See polygon_get_xs().
+ *
+ * @param polygon a pointer to a polygon returned from polygon_init()
+ * @return the y coordinates of the vertices
+ */
+const double *polygon_get_ys(const polygon_t *polygon);
+
+/**
+ * Computes the area of a polygon. See polygon_area().
+ *
+ * @param polygon a polygon listed in a counterclockwise direction
+ * @return the area of the polygon
+ */
+double polygon_get_area(const polygon_t *polygon);
+
+/**
+ * Computes the center of mass of a polygon. See polygon_centroid().
+ *
+ * @param polygon a polygon listed in a counterclockwise direction
+ * @return the centroid of the polygon
+ */
+vector_t polygon_get_centroid(const polygon_t *polygon);
+
+/**
+ * Translates all vertices in a polygon by a given vector.
+ * Note: mutates the original polygon.
+ *
+ * @param polygon a pointer to a polygon returned from polygon_init()
+ * @param translation the vector to add to each vertex's position
+ */
+void polygon_translate_vertices(polygon_t *polygon, vector_t translation);
+
+/**
+ * Rotates the vertices of a polygon by a given angle about a given point.
+ * Note: mutates the original polygon.
+ *
+ * @param polygon a pointer to a polygon returned from polygon_init()
+ * @param angle the angle to rotate the polygon, in radians.
+ * A positive angle means counterclockwise.
+ * @param point the point to rotate around
+ */
+void polygon_rotate_vertices(polygon_t *polygon, double angle, vector_t point);
+
+/**
+ * Writes the vertices of a polygon, rotated about the origin and then
+ * translated, into another polygon. This is how a shape stored in local
+ * coordinates is placed in the world.
+ *
+ * @param result the polygon to overwrite; it is resized to match polygon
+ * and must not be the same polygon
+ * @param polygon the vertices to transform
+ * @param angle the angle to rotate the vertices by, in radians
+ * @param translation the vector to add to each rotated vertex
+ */
+void polygon_transform(polygon_t *result, const polygon_t *polygon,
+                       double angle, vector_t translation);
+
+/**
+ * Computes the smallest and largest dot products of a polygon's vertices
+ * with an axis. For a unit axis these are the bounds of the polygon's
+ * projection onto that axis.
+ *
+ * @param polygon a pointer to a polygon with at least one vertex
+ * @param axis the axis to project onto; it need not be normalized
+ * @param min where to store the smallest dot product
+ * @param max where to store the largest dot product
+ */
+void polygon_project(const polygon_t *polygon, vector_t axis, double *min,
+                     double *max);
+
+/**
+ * Checks whether every turn of a polygon goes the same way by a clear
+ * margin, so that it has no straight runs, repeated vertices or dents, not
+ * even ones left by rounding. The answer is cached until the vertices
+ * change.
+ *
+ * @param polygon a pointer to a polygon
+ * @return whether the polygon is strictly convex
+ */
+bool polygon_is_strictly_convex(const polygon_t *polygon);
+
+/**
+ * Finds the vertex of a polygon furthest along a direction. Strictly convex
+ * polygons (see polygon_is_strictly_convex()) are climbed from a starting
+ * vertex towards it, with steps that double while they keep climbing. This
+ * takes O(log n) steps from any start, and O(1) from a start at or next to
+ * the answer, e.g. the answer for a direction turned slightly from this
+ * one. Other polygons are scanned, so the answer is always exact.
+ *
+ * @param polygon a pointer to a polygon with at least one vertex
+ * @param direction the direction to search in; it need not be normalized
+ * @param start the index of the vertex to start from
+ * @return the index of a vertex with the largest dot product with direction
+ */
+size_t polygon_extreme_vertex(const polygon_t *polygon, vector_t direction,
+                              size_t start);
+
+/**
+ * Computes the same bounds as polygon_project() for a convex polygon.
+ * Strictly convex polygons with many vertices are projected by climbing to
+ * their extreme vertices with polygon_extreme_vertex() rather than scanning
+ * every vertex.
+ *
+ * @param polygon a pointer to a convex polygon with at least one vertex
+ * @param axis the axis to project onto; it need not be normalized
+ * @param min_vertex the index of the vertex to start the search for the
+ *   smallest dot product from, e.g. the answer for the last axis; set to
+ *   that vertex if the polygon was climbed
+ * @param max_vertex the same for the largest dot product
+ * @param min where to store the smallest dot product
+ * @param max where to store the largest dot product
+ */
+void polygon_project_convex(const polygon_t *polygon, vector_t axis,
+                            size_t *min_vertex, size_t *max_vertex,
+                            double *min, double *max);
+
+/**
+ * Finds the vertices of a polygon with the smallest and largest dot
+ * products with each of a set of axes, e.g. the polygon's own normals.
+ * Rotating and translating the polygon leaves these vertices the same, so
+ * a body can find them once and start each search with
+ * polygon_project_convex() at the answer.
+ *
+ * @param polygon a pointer to a polygon with at least one vertex
+ * @param axes the axes, e.g. from polygon_get_normals()
+ * @return a newly allocated array of 2 * polygon_size(axes) vertex indices:
+ *   the smallest and then the largest for each axis in turn, which must be
+ *   free()d
+ */
+size_t *polygon_get_extremes(const polygon_t *polygon, const polygon_t *axes);
+
+/**
+ * Finds a polygon's extreme vertices along a set of axes into an arena.
+ * See polygon_get_extremes(). If arena is NULL, the array must be free()d.
+ *
+ * @param arena a pointer to an arena returned from arena_init(), or NULL
+ * @param polygon a pointer to a polygon with at least one vertex
+ * @param axes the axes, e.g. from polygon_get_normals()
+ * @return an array of 2 * polygon_size(axes) vertex indices in the arena
+ */
+size_t *polygon_get_extremes_in(arena_t *arena, const polygon_t *polygon,
+                                const polygon_t *axes);
+
+/**
+ * Finds the vertex of a convex polygon furthest along a direction: the
+ * support point used by find_convex_distance(). Polygons with many vertices
+ * are searched with polygon_extreme_vertex(), starting from the vertex this
+ * last returned for the polygon.
+ *
+ * @param polygon a pointer to a convex polygon with at least one vertex
+ * @param direction the direction to search in; it need not be normalized
+ * @return a vertex with the largest dot product with direction
+ */
+vector_t polygon_support(const polygon_t *polygon, vector_t direction);
+
+/**
+ * Computes the smallest axis-aligned box containing a polygon.
+ * The result is cached until the polygon's vertices next change,
+ * so repeated calls are O(1).
+ *
+ * @param polygon a pointer to a polygon with at least one vertex
+ * @return the polygon's bounding box
+ */
+aabb_t polygon_get_bounds(const polygon_t *polygon);
+
+/**
+ * Checks whether two bounding boxes overlap.
+ * Boxes that only touch along an edge or corner count as overlapping,
+ * matching find_collision(), which reports touching shapes as colliding.
+ *
+ * @param box1 the first bounding box
+ * @param box2 the second bounding box
+ * @return whether the boxes share at least one point
+ */
+bool aabb_overlaps(aabb_t box1, aabb_t box2);
+
+/**
+ * Computes the unit normals of a polygon's edges, keeping only one of each
+ * set of parallel normals. These are the axes a separating axis test needs,
+ * e.g. a rectangle has only 2. Normals appear in the order of their first
+ * edge, and zero-length edges are skipped.
+ *
+ * @param polygon a pointer to a polygon returned from polygon_init()
+ * @return a newly allocated polygon_t holding one unit vector per distinct
+ * edge direction, which must be polygon_free()d
+ */
+polygon_t *polygon_get_normals(const polygon_t *polygon);
+
+/**
+ * Computes the distinct unit edge normals of a polygon into an arena.
+ * See polygon_get_normals() and polygon_init_in().
+ *
+ * @param arena a pointer to an arena returned from arena_init(), or NULL
+ * @param polygon a pointer to a polygon returned from polygon_init()
+ * @return a polygon_t in the arena holding one unit vector per distinct
+ * edge direction
+ */
+polygon_t *polygon_get_normals_in(arena_t *arena, const polygon_t *polygon);
+
+/**
+ * Checks whether a polygon is convex, allowing for nearly straight corners.
+ * The vertices may be listed in either direction.
+ *
+ * @param polygon a pointer to a polygon returned from polygon_init()
+ * @return whether every corner turns the same way
+ */
+bool polygon_is_convex(const polygon_t *polygon);
+
+/**
+ * Splits a polygon into convex parts that cover it, by ear clipping followed
+ * by Hertel-Mehlhorn merging (at most 4 times the fewest possible parts).
+ * A convex polygon comes back as a single copy. This is O(n^2) in the worst
+ * case, so it is meant to be run once per shape, not once per tick.
+ *
+ * @param polygon a pointer to a polygon returned from polygon_init(); its
+ * vertices may be listed in either direction
+ * @return a list of newly allocated polygon_t parts, each listed
+ * counterclockwise, which frees the parts when list_free()d
+ */
+list_t *polygon_decompose(const polygon_t *polygon);
+
+/**
+ * Simplifies a polygon with the Douglas-Peucker algorithm: vertices are
+ * dropped as long as every dropped vertex stays within tolerance of the
+ * edge that replaces it. The result keeps the vertices' order and is a
+ * subset of them, so it never extends past the original's bounds.
+ *
+ * @param polygon a pointer to a polygon returned from polygon_init()
+ * @param tolerance the largest distance a dropped vertex may be from the
+ * simplified outline
+ * @return a newly allocated polygon_t with at least
+ * min(3, polygon_size(polygon)) vertices, which must be polygon_free()d
+ */
+polygon_t *polygon_simplify(const polygon_t *polygon, double tolerance);
+
 #endif // #ifndef __POLYGON_H__
@@ -0,0 +1,67 @@
+#ifndef __POOL_H__
+#define __POOL_H__
+
+#include <stddef.h>
+
+/**
+ * A slab allocator for records of one fixed size.
+ * Records are carved out of large slabs, so allocating and releasing them
+ * only touches the pool's free list, and freeing the pool releases every
+ * record at once by freeing its slabs.
+ */
+typedef struct pool pool_t;
+
+/**
+ * Allocates memory for a new pool.
+ * Asserts that the required memory was allocated.
+ *
+ * @param record_size the size of each record in bytes
+ * @param initial_records the number of records to allocate space for.
+ *   The pool grows by whole slabs when it runs out of records.
+ * @return a pointer to the newly allocated pool
+ */
+pool_t *pool_init(size_t record_size, size_t initial_records);
+
+/**
+ * Releases the memory allocated for a pool,
+ * including every record allocated from it, whether released or not.
+ *
+ * @param pool a pointer to a pool returned from pool_init()
+ */
+void pool_free(pool_t *pool);
+
+/**
+ * Allocates a record from a pool.
+ * The record is suitably aligned for any type, and stays valid until it is
+ * passed to pool_release() or the pool is freed.
+ *
+ * @param pool a pointer to a pool returned from pool_init()
+ * @return a pointer to an uninitialized record
+ */
+void *pool_alloc(pool_t *pool);
+
+/**
+ * Returns a record to the pool it was allocated from, so it can be reused.
+ * This takes only the record, so it can be used as a free_func_t.
+ *
+ * @param record a pointer returned from pool_alloc()
+ */
+void pool_release(void *record);
+
+/**
+ * Gets the size of the records in a pool.
+ *
+ * @param pool a pointer to a pool returned from pool_init()
+ * @return the record_size passed to pool_init()
+ */
+size_t pool_record_size(pool_t *pool);
+
+/**
+ * Gets the number of records currently allocated from a pool.
+ *
+ * @param pool a pointer to a pool returned from pool_init()
+ * @return the number of records allocated and not yet released
+ */
+size_t pool_records(pool_t *pool);
+
+#endif // #ifndef __POOL_H__
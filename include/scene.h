@@ -1,8 +1,11 @@
 #ifndef __SCENE_H__
 #define __SCENE_H__
 
+#include "arena.h"
 #include "body.h"
+#include "collision.h"
 #include "list.h"
+#include "pool.h"
 
 /**
  * A collection of bodies and force creators.
@@ -18,6 +21,13 @@ typedef struct scene scene_t;
  */
 typedef void (*force_creator_t)(void *aux);
 
+/**
+ * A force creator registered with a scene.
+ * Returned when the force creator is added, so it can later be removed
+ * with scene_remove_force_creator().
+ */
+typedef struct force force_t;
+
 /**
  * Allocates memory for an empty scene.
  * Makes a reasonable guess of the number of bodies to allocate space for.
@@ -27,6 +37,18 @@ typedef void (*force_creator_t)(void *aux);
  */
 scene_t *scene_init(void);
 
+/**
+ * Allocates memory for an empty scene with room for the given numbers of
+ * bodies and force creators, so that loading a level of about that size
+ * does not need to grow the scene's lists and pools.
+ * Asserts that the required memory is successfully allocated.
+ *
+ * @param num_bodies the number of bodies to allocate space for
+ * @param num_forces the number of force creators to allocate space for
+ * @return the new scene
+ */
+scene_t *scene_init_with_capacity(size_t num_bodies, size_t num_forces);
+
 /**
  * Releases memory allocated for a given scene
  * and all the bodies and force creators it contains.
@@ -76,8 +98,8 @@ void scene_remove_body(scene_t *scene, size_t index);
  * @deprecated Use scene_add_bodies_force_creator() instead
  * so the scene knows which bodies the force creator depends on
  */
-void scene_add_force_creator(scene_t *scene, force_creator_t forcer, void *aux,
-                             free_func_t freer);
+force_t *scene_add_force_creator(scene_t *scene, force_creator_t forcer,
+                                 void *aux, free_func_t freer);
 
 /**
  * Adds a force creator to a scene,
@@ -93,10 +115,97 @@ void scene_add_force_creator(scene_t *scene, force_creator_t forcer, void *aux,
  *   The force creator will be removed if any of these bodies are removed.
  *   This list does not own the bodies, so its freer should be NULL.
  * @param freer if non-NULL, a function to call in order to free aux
+ * @return a handle to the force creator, valid until it is removed
+ */
+force_t *scene_add_bodies_force_creator(scene_t *scene, force_creator_t forcer,
+                                        void *aux, list_t *bodies,
+                                        free_func_t freer);
+
+/**
+ * Adds a force creator that only acts while two bodies are in contact,
+ * such as a collision or normal force.
+ * The scene keeps a broadphase of the bodies' bounding boxes and skips the
+ * force creator on ticks when the boxes do not overlap, so its cost scales
+ * with the number of nearby pairs instead of the number of registered pairs.
+ * The force creator still runs on its first tick and on the first tick
+ * after the boxes stop overlapping, so it can observe the separation.
+ * Otherwise this behaves like scene_add_bodies_force_creator().
+ *
+ * All contact force creators on the same ordered pair of bodies share one
+ * contact (see force_get_contact()), so they can read a single cached
+ * narrowphase result with contact_get_collision() instead of each testing
+ * the pair again.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param forcer a force creator function that has no effect
+ *   unless the two bodies' shapes intersect
+ * @param aux an auxiliary value to pass to forcer when it is called
+ * @param bodies a list of exactly the two bodies in contact.
+ *   This list does not own the bodies, so its freer should be NULL.
+ * @param freer if non-NULL, a function to call in order to free aux
+ * @return a handle to the force creator, valid until it is removed
+ */
+force_t *scene_add_contact_force_creator(scene_t *scene,
+                                         force_creator_t forcer, void *aux,
+                                         list_t *bodies, free_func_t freer);
+
+/**
+ * Gets the contact shared by the contact force creators on a pair of bodies.
+ *
+ * @param force a handle returned from scene_add_contact_force_creator()
+ * @return the pair's contact, which stays valid as long as the force creator,
+ *   or NULL if the force creator was not added as a contact force creator
+ */
+contact_t *force_get_contact(force_t *force);
+
+/**
+ * Removes a force creator from a scene in O(1) and frees it
+ * (and its auxiliary value) by the end of the next scene_tick().
+ * The force creator is no longer invoked once it has been removed.
+ * Asserts that the force creator has not already been removed.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param force a handle returned when the force creator was added
+ */
+void scene_remove_force_creator(scene_t *scene, force_t *force);
+
+/**
+ * Gets a scene's scratch arena, for temporary allocations such as
+ * intermediate geometry in force creators and collision handlers.
+ * The arena is reset at the start of every scene_tick(), so anything
+ * allocated from it is only valid until the next tick begins.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @return the scene's scratch arena
+ */
+arena_t *scene_get_scratch(scene_t *scene);
+
+/**
+ * Gets the arena a scene keeps for the bodies of its level, to pass to
+ * body_init_with_info_in() and the like. Bodies allocated from it may only
+ * be added to this scene. scene_free() frees their info and lists of forces,
+ * including those of bodies unloaded with scene_unload_bodies(), and then
+ * releases the arena, and with it every body, at once.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @return the scene's body arena
+ */
+arena_t *scene_get_body_arena(scene_t *scene);
+
+/**
+ * Allocates a small record, such as a force creator's auxiliary value,
+ * from a pool owned by the scene. Records are large enough for a contact
+ * (see contact_init_in()) or the arguments of any force creator in forces.h.
+ * A record should be released with pool_release(), which can be passed
+ * as the freer when adding a force creator. Any records still allocated
+ * are released all at once by scene_free().
+ * Asserts that the size fits in a record.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param size the number of bytes needed
+ * @return a pointer to an uninitialized record
  */
-void scene_add_bodies_force_creator(scene_t *scene, force_creator_t forcer,
-                                    void *aux, list_t *bodies,
-                                    free_func_t freer);
+void *scene_alloc_record(scene_t *scene, size_t size);
 
 /**
  * Executes a tick of a given scene over a small time interval.
@@ -104,6 +213,10 @@ void scene_add_bodies_force_creator(scene_t *scene, force_creator_t forcer,
  * and then ticking each body (see body_tick()).
  * If any bodies are marked for removal, they should be removed from the scene
  * and freed, along with any force creators acting on them.
+ * Bullets (see body_set_bullet()) that moved far are pulled back to their
+ * time of impact with the first body they share a contact force creator with
+ * but did not already touch, so the contact is handled on the next tick.
+ * Only the translation is swept; the body keeps its new rotation.
  *
  * @param scene a pointer to a scene returned from scene_init()
  * @param dt the time elapsed since the last tick, in seconds
@@ -111,7 +224,9 @@ void scene_add_bodies_force_creator(scene_t *scene, force_creator_t forcer,
 void scene_tick(scene_t *scene, double dt);
 
 /**
- * Removes a particular type of force from a given scene
+ * Removes every force creator of a particular type from a scene and frees
+ * them (and their auxiliary values) by the end of the next scene_tick().
+ * May be called from a force creator while the scene is ticking.
  *
  * @param scene a pointer to a scene returned from scene_init()
  * @param force_type the type of force to remove from the scene
@@ -119,7 +234,10 @@ void scene_tick(scene_t *scene, double dt);
 void scene_remove_force(scene_t *scene, force_creator_t force_type);
 
 /**
- * Unloads all bodies and forces onto given lists
+ * Unloads all bodies and forces onto given lists.
+ * The scene keeps owning them: they may only be loaded back into the same
+ * scene with scene_load_bodies(), and scene_free() frees any that were not
+ * loaded back, so the lists must not be used after the scene is freed.
  *
  * @param scene a pointer to a scene returned from scene_init()
  * @param bodies the list to store the bodies
@@ -128,7 +246,8 @@ void scene_remove_force(scene_t *scene, force_creator_t force_type);
 void scene_unload_bodies(scene_t *scene, list_t *bodies, list_t *forces);
 
 /**
- * Loads all bodies and forces from given lists into scene
+ * Loads all bodies and forces from given lists into scene.
+ * Asserts that they were unloaded from this scene by scene_unload_bodies().
  *
  * @param scene a pointer to a scene returned from scene_init()
  * @param bodies the list with the bodies to import
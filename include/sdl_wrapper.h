@@ -3,6 +3,7 @@
 
 #include "color.h"
 #include "list.h"
+#include "polygon.h"
 #include "scene.h"
 #include "state.h"
 #include "vector.h"
@@ -142,6 +143,7 @@ void sound_play();
 
 /**
  * Clears the screen. Should be called before drawing polygons in each frame.
+ * Also releases the scratch memory used to draw the previous frame.
  */
 void sdl_clear(void);
 
@@ -153,6 +155,24 @@ void sdl_clear(void);
  */
 void sdl_draw_polygon(list_t *points, rgb_color_t color);
 
+/**
+ * Draws a polygon stored in a contiguous vertex buffer and a color.
+ *
+ * @param shape the polygon to draw
+ * @param color the color used to fill in the polygon
+ */
+void sdl_draw_shape(const polygon_t *shape, rgb_color_t color);
+
+/**
+ * Draws a filled circle of the given color.
+ *
+ * @param circle_center the center of the circle, in scene coordinates
+ * @param radius the radius of the circle, in scene units
+ * @param color the color used to fill in the circle
+ */
+void sdl_draw_circle(vector_t circle_center, double radius,
+                     rgb_color_t color);
+
 /**
  * Displays the rendered frame on the SDL window.
  * Must be called after drawing the polygons in order to show them.
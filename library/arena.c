@@ -0,0 +1,66 @@
+#include "arena.h"
+#include "list.h"
+#include <assert.h>
+#include <stdalign.h>
+#include <stdlib.h>
+
+const size_t ARENA_SCALING_FACTOR = 2;
+const size_t ARENA_ALIGNMENT = alignof(max_align_t);
+
+typedef struct arena {
+  char *data;
+  size_t size;
+  size_t capacity;
+  // blocks the arena has outgrown, which are freed on the next reset
+  list_t *old_blocks;
+  // bytes allocated from the old blocks since the last reset
+  size_t old_size;
+} arena_t;
+
+arena_t *arena_init(size_t initial_size) {
+  arena_t *result = malloc(sizeof(arena_t));
+  assert(result != NULL);
+  result->capacity = initial_size > 0 ? initial_size : ARENA_ALIGNMENT;
+  result->data = malloc(result->capacity);
+  assert(result->data != NULL);
+  result->size = 0;
+  result->old_blocks = list_init(1, free);
+  result->old_size = 0;
+  return result;
+}
+
+void arena_free(arena_t *arena) {
+  list_free(arena->old_blocks);
+  free(arena->data);
+  free(arena);
+}
+
+void *arena_alloc(arena_t *arena, size_t size) {
+  // Round up so every allocation starts on an aligned boundary
+  size = (size + ARENA_ALIGNMENT - 1) / ARENA_ALIGNMENT * ARENA_ALIGNMENT;
+  if (arena->size + size > arena->capacity) {
+    list_add(arena->old_blocks, arena->data);
+    arena->old_size += arena->size;
+    size_t capacity = arena->capacity * ARENA_SCALING_FACTOR;
+    while (capacity < size) {
+      capacity *= ARENA_SCALING_FACTOR;
+    }
+    arena->data = malloc(capacity);
+    assert(arena->data != NULL);
+    arena->capacity = capacity;
+    arena->size = 0;
+  }
+  void *result = arena->data + arena->size;
+  arena->size += size;
+  return result;
+}
+
+void arena_reset(arena_t *arena) {
+  while (list_size(arena->old_blocks) > 0) {
+    free(list_remove(arena->old_blocks, list_size(arena->old_blocks) - 1));
+  }
+  arena->old_size = 0;
+  arena->size = 0;
+}
+
+size_t arena_used(arena_t *arena) { return arena->old_size + arena->size; }
@@ -1,5 +1,7 @@
 #include "body.h"
+#include "chain.h"
 #include "color.h"
+#include "heightfield.h"
 #include "list.h"
 #include "polygon.h"
 #include "vector.h"
@@ -8,8 +10,63 @@
 #include <stdbool.h>
 #include <stdlib.h>
 
+// vertices of the polygon kept by a circle body for code that needs an
+// outline; a multiple of 4, so the polygon's bounding box is the circle's
+const size_t CIRCLE_OUTLINE_POINTS = 32;
+
+// A convex piece of a concave body, in local and world coordinates
+typedef struct body_part {
+  polygon_t *local_polygon;
+  polygon_t *polygon;
+  polygon_t *local_normals;
+  polygon_t *normals;
+  // the part's extreme vertices along each of its normals, see
+  // polygon_get_extremes()
+  size_t *extremes;
+} body_part_t;
+
 typedef struct body {
-  list_t *polygon;
+  // shape relative to origin, before rotation by angle
+  polygon_t *local_polygon;
+  // local_polygon placed in the world; only recomputed when shape_dirty
+  polygon_t *polygon;
+  bool shape_dirty;
+  // distinct unit edge normals of local_polygon, and the same normals rotated
+  // by normals_angle; only found once a collision needs them (else NULL)
+  polygon_t *local_normals;
+  polygon_t *normals;
+  double normals_angle;
+  // extreme vertices of local_polygon along each of local_normals, found
+  // along with them
+  size_t *extremes;
+  // if positive, collisions use local_polygon simplified by this much
+  double collision_tolerance;
+  // convex parts of the collision shape, unless it is local_polygon itself
+  // and convex (then NULL and 0); placed in the world when parts_dirty
+  body_part_t *parts;
+  size_t num_parts;
+  // set when the parts must be rebuilt from the local shape before the next
+  // collision query, so bodies that never collide are never decomposed
+  bool local_parts_dirty;
+  bool parts_dirty;
+  double parts_angle;
+  // if non-NULL, the parts are this heightfield's columns
+  heightfield_t *heightfield;
+  // if non-NULL, the body collides as this chain and has no parts
+  chain_t *chain;
+  // adding this to local coordinates gives the heightfield's or chain's own
+  vector_t shape_offset;
+  // if positive, the body collides as a circle of this radius about its
+  // centroid, and local_polygon only approximates it
+  double radius;
+  // incremented whenever the world shape changes, see body_update_bounds()
+  size_t shape_version;
+  vector_t origin;
+  // bounds of local_polygon, and the largest distance of a vertex from origin
+  aabb_t local_bounds;
+  double bounding_radius;
+  // world-space bounding box, kept up to date as the body moves
+  aabb_t bounds;
   double mass;
   double angle;
   double moment_of_inertia;
@@ -20,28 +77,245 @@ typedef struct body {
   vector_t force;
   vector_t impulse;
   vector_t reference_vector;
-  vector_t *reference_pointer;
   rgb_color_t color;
   double angular_velocity;
   double angular_acceleration;
   double torque;
   double angular_impulse;
   bool removed;
+  motion_type_t motion_type;
+  bool decoration;
+  // whether the scene sweeps the body's steps for contacts, see body_set_bullet
+  bool bullet;
   vector_t curr_pivot_point;
   void *info;
   free_func_t info_freer;
+  // force creators acting on the body, maintained by the scene
+  list_t *forces;
+  // where the scene last put the body's broadphase proxy
+  size_t proxy_index;
+  // if non-NULL, the body and its shapes live in this arena and are released
+  // along with it, see body_init_with_info_in()
+  arena_t *arena;
 } body_t;
 
-body_t *body_init(list_t *shape, double mass, rgb_color_t color) {
-  body_t *result = malloc(sizeof(body_t));
+// Allocates memory for the body's shapes from its arena, if it has one
+void *body_alloc(body_t *body, size_t size) {
+  void *result =
+      body->arena != NULL ? arena_alloc(body->arena, size) : malloc(size);
+  assert(result != NULL);
+  return result;
+}
+
+// Frees memory from body_alloc(), unless its arena releases it instead
+void body_release(body_t *body, void *memory) {
+  if (body->arena == NULL) {
+    free(memory);
+  }
+}
+
+// Recomputes the local bounding box and radius after local_polygon changes
+void body_update_local_bounds(body_t *body) {
+  body->local_bounds = polygon_get_bounds(body->local_polygon);
+  const double *xs = polygon_get_xs(body->local_polygon);
+  const double *ys = polygon_get_ys(body->local_polygon);
+  double max_distance_squared = 0.0;
+  for (size_t i = 0; i < polygon_size(body->local_polygon); i++) {
+    max_distance_squared =
+        fmax(max_distance_squared, xs[i] * xs[i] + ys[i] * ys[i]);
+  }
+  body->bounding_radius = sqrt(max_distance_squared);
+}
+
+void body_free_parts(body_t *body) {
+  for (size_t i = 0; i < body->num_parts; i++) {
+    polygon_free(body->parts[i].local_polygon);
+    polygon_free(body->parts[i].polygon);
+    polygon_free(body->parts[i].local_normals);
+    polygon_free(body->parts[i].normals);
+    body_release(body, body->parts[i].extremes);
+  }
+  body_release(body, body->parts);
+  body->parts = NULL;
+  body->num_parts = 0;
+}
+
+// Makes one part for each of the heightfield's columns
+void body_update_heightfield_parts(body_t *body) {
+  body->num_parts = heightfield_num_columns(body->heightfield);
+  body->parts = body_alloc(body, sizeof(body_part_t) * body->num_parts);
+  for (size_t i = 0; i < body->num_parts; i++) {
+    polygon_t *column =
+        heightfield_get_column_in(body->arena, body->heightfield, i);
+    polygon_translate_vertices(column, vec_negate(body->shape_offset));
+    polygon_t *normals = polygon_get_normals_in(body->arena, column);
+    body->parts[i] = (body_part_t){
+        .local_polygon = column,
+        .polygon = polygon_init_in(body->arena, 4),
+        .local_normals = normals,
+        .normals = polygon_init_in(body->arena, 1),
+        .extremes = polygon_get_extremes_in(body->arena, column, normals)};
+  }
+  body->parts_dirty = true;
+  body->parts_angle = NAN;
+}
+
+// Builds the collision shape from local_polygon, simplified if the body has
+// a collision tolerance, and splits it into convex parts. If that leaves
+// local_polygon as is, collisions use the body's own polygon and normals.
+void body_update_local_parts(body_t *body) {
+  body_free_parts(body);
+  body->local_parts_dirty = false;
+  if (body->heightfield != NULL) {
+    body_update_heightfield_parts(body);
+    return;
+  }
+  if (body->chain != NULL) {
+    return;
+  }
+  polygon_t *proxy = NULL;
+  if (body->collision_tolerance > 0) {
+    proxy = polygon_simplify(body->local_polygon, body->collision_tolerance);
+  }
+  list_t *parts =
+      polygon_decompose(proxy != NULL ? proxy : body->local_polygon);
+  if (proxy != NULL) {
+    polygon_free(proxy);
+  }
+  if (list_size(parts) > 1 || body->collision_tolerance > 0) {
+    body->num_parts = list_size(parts);
+    body->parts = body_alloc(body, sizeof(body_part_t) * body->num_parts);
+    for (size_t i = 0; i < body->num_parts; i++) {
+      polygon_t *part = list_get(parts, i);
+      polygon_t *normals = polygon_get_normals_in(body->arena, part);
+      body->parts[i] = (body_part_t){
+          .local_polygon = polygon_copy_in(body->arena, part),
+          .polygon = polygon_init_in(body->arena, polygon_size(part)),
+          .local_normals = normals,
+          .normals = polygon_init_in(body->arena, 1),
+          .extremes = polygon_get_extremes_in(body->arena, part, normals)};
+    }
+  }
+  list_free(parts);
+  body->parts_dirty = true;
+  body->parts_angle = NAN;
+}
+
+// Rebuilds the parts if the local shape or collision tolerance has changed
+// since they were built
+void body_ensure_local_parts(body_t *body) {
+  if (body->local_parts_dirty) {
+    body_update_local_parts(body);
+  }
+}
+
+// Finds the distinct normals of local_polygon and its extreme vertices along
+// them, if they haven't been found since local_polygon last changed
+void body_ensure_local_normals(body_t *body) {
+  if (body->local_normals != NULL) {
+    return;
+  }
+  body->local_normals =
+      polygon_get_normals_in(body->arena, body->local_polygon);
+  body->extremes = polygon_get_extremes_in(body->arena, body->local_polygon,
+                                           body->local_normals);
+  body->normals_angle = NAN;
+}
+
+// Places the convex parts in the world, rotating their normals only if the
+// body has turned since they were last placed
+void body_update_parts(body_t *body) {
+  if (!body->parts_dirty) {
+    return;
+  }
+  bool rotated = body->parts_angle != body->angle;
+  for (size_t i = 0; i < body->num_parts; i++) {
+    body_part_t *part = &body->parts[i];
+    polygon_transform(part->polygon, part->local_polygon, body->angle,
+                      body->origin);
+    if (rotated) {
+      polygon_transform(part->normals, part->local_normals, body->angle,
+                        VEC_ZERO);
+    }
+  }
+  body->parts_angle = body->angle;
+  body->parts_dirty = false;
+}
+
+// Places the local bounding box in the world in O(1). When the body is
+// rotated, this is the box around the rotated local box, clipped to the
+// box around the bounding circle, so it may be slightly larger than the
+// exact bounds of the vertices.
+void body_update_bounds(body_t *body) {
+  body->shape_version++;
+  body->parts_dirty = true;
+  aabb_t local = body->local_bounds;
+  vector_t origin = body->origin;
+  if (body->angle == 0.0) {
+    body->bounds = (aabb_t){.min = vec_add(local.min, origin),
+                            .max = vec_add(local.max, origin)};
+    return;
+  }
+  double cos_angle = cos(body->angle);
+  double sin_angle = sin(body->angle);
+  double x_cos[] = {local.min.x * cos_angle, local.max.x * cos_angle};
+  double x_sin[] = {local.min.x * sin_angle, local.max.x * sin_angle};
+  double y_cos[] = {local.min.y * cos_angle, local.max.y * cos_angle};
+  double y_sin[] = {local.min.y * sin_angle, local.max.y * sin_angle};
+  // x' = x cos - y sin and y' = x sin + y cos are extremal at the corners
+  double min_x = fmin(x_cos[0], x_cos[1]) - fmax(y_sin[0], y_sin[1]);
+  double max_x = fmax(x_cos[0], x_cos[1]) - fmin(y_sin[0], y_sin[1]);
+  double min_y = fmin(x_sin[0], x_sin[1]) + fmin(y_cos[0], y_cos[1]);
+  double max_y = fmax(x_sin[0], x_sin[1]) + fmax(y_cos[0], y_cos[1]);
+  double r = body->bounding_radius;
+  body->bounds = (aabb_t){
+      .min = {origin.x + fmax(min_x, -r), origin.y + fmax(min_y, -r)},
+      .max = {origin.x + fmin(max_x, r), origin.y + fmin(max_y, r)}};
+}
+
+// Makes a body out of polygon, which it takes ownership of. If heightfield or
+// chain is non-NULL, it is the body's collision shape, in world coordinates.
+// If arena is non-NULL, the body and its shapes are allocated from it.
+body_t *body_init_polygon(arena_t *arena, polygon_t *polygon, double mass,
+                          rgb_color_t color, heightfield_t *heightfield,
+                          chain_t *chain) {
+  body_t *result = arena != NULL ? arena_alloc(arena, sizeof(body_t))
+                                 : malloc(sizeof(body_t));
   assert(result != NULL);
+  result->arena = arena;
 
-  result->polygon = shape;
+  result->polygon = polygon;
+  result->shape_dirty = false;
+  result->shape_version = 0;
   result->mass = mass;
   result->angle = 0.0;
   result->moment_of_inertia = INFINITY;
   result->curr_moment_of_inertia = INFINITY;
-  result->centroid = polygon_centroid(shape);
+  if (chain != NULL) {
+    // An open chain's outline may enclose no area
+    aabb_t bounds = chain_get_bounds(chain);
+    result->centroid = vec_multiply(0.5, vec_add(bounds.min, bounds.max));
+  } else {
+    result->centroid = polygon_get_centroid(result->polygon);
+  }
+  result->origin = result->centroid;
+  result->local_polygon = polygon_copy_in(arena, result->polygon);
+  polygon_translate_vertices(result->local_polygon,
+                             vec_negate(result->centroid));
+  result->local_normals = NULL;
+  result->normals = polygon_init_in(arena, 1);
+  result->extremes = NULL;
+  result->normals_angle = NAN;
+  result->collision_tolerance = 0.0;
+  result->parts = NULL;
+  result->num_parts = 0;
+  result->heightfield = heightfield;
+  result->chain = chain;
+  result->shape_offset = result->centroid;
+  result->radius = 0.0;
+  result->local_parts_dirty = true;
+  body_update_local_bounds(result);
+  body_update_bounds(result);
   result->color = color;
   result->angular_velocity = 0.0;
   result->angular_acceleration = 0.0;
@@ -51,42 +325,254 @@ body_t *body_init(list_t *shape, double mass, rgb_color_t color) {
   result->acceleration = VEC_ZERO;
   result->force = VEC_ZERO;
   result->impulse = VEC_ZERO;
-  result->reference_pointer = list_get(shape, 0);
-  result->reference_vector =
-      vec_subtract(*result->reference_pointer, result->centroid);
+  result->reference_vector = vec_subtract(
+      polygon_get_vertex(result->polygon, 0), result->centroid);
   result->removed = 0;
-  result->curr_pivot_point = polygon_centroid(shape);
+  result->motion_type = MOTION_DYNAMIC;
+  result->decoration = false;
+  result->bullet = false;
+  result->curr_pivot_point = result->centroid;
   result->info = NULL;
   result->info_freer = NULL;
+  result->forces = list_init(1, NULL);
+  result->proxy_index = 0;
   return result;
 }
 
+body_t *body_init(list_t *shape, double mass, rgb_color_t color) {
+  return body_init_with_info(shape, mass, color, NULL, NULL);
+}
+
 body_t *body_init_with_info(list_t *shape, double mass, rgb_color_t color,
                             void *info, free_func_t info_freer) {
-  body_t *body = body_init(shape, mass, color);
+  return body_init_with_info_in(NULL, shape, mass, color, info, info_freer);
+}
+
+body_t *body_init_with_info_in(arena_t *arena, list_t *shape, double mass,
+                               rgb_color_t color, void *info,
+                               free_func_t info_freer) {
+  polygon_t *polygon = polygon_from_list_in(arena, shape);
+  list_free(shape);
+  body_t *body = body_init_polygon(arena, polygon, mass, color, NULL, NULL);
+  body->info = info;
+  body->info_freer = info_freer;
+  return body;
+}
+
+body_t *body_init_static(list_t *shape, rgb_color_t color) {
+  return body_init_static_with_info(shape, color, NULL, NULL);
+}
+
+body_t *body_init_static_with_info(list_t *shape, rgb_color_t color,
+                                   void *info, free_func_t info_freer) {
+  body_t *body = body_init_with_info(shape, INFINITY, color, info, info_freer);
+  body->motion_type = MOTION_STATIC;
+  return body;
+}
+
+body_t *body_init_heightfield(heightfield_t *heightfield, rgb_color_t color,
+                              void *info, free_func_t info_freer) {
+  return body_init_heightfield_in(NULL, heightfield, color, info, info_freer);
+}
+
+body_t *body_init_heightfield_in(arena_t *arena, heightfield_t *heightfield,
+                                 rgb_color_t color, void *info,
+                                 free_func_t info_freer) {
+  body_t *body =
+      body_init_polygon(arena, heightfield_get_outline_in(arena, heightfield),
+                        INFINITY, color, heightfield, NULL);
+  body->motion_type = MOTION_STATIC;
+  body->info = info;
+  body->info_freer = info_freer;
+  return body;
+}
+
+body_t *body_init_chain(chain_t *chain, rgb_color_t color, void *info,
+                        free_func_t info_freer) {
+  body_t *body = body_init_polygon(NULL, chain_get_outline(chain), INFINITY,
+                                   color, NULL, chain);
+  body->motion_type = MOTION_STATIC;
+  body->info = info;
+  body->info_freer = info_freer;
+  return body;
+}
+
+body_t *body_init_circle(vector_t center, double radius, double mass,
+                         rgb_color_t color, void *info,
+                         free_func_t info_freer) {
+  assert(radius > 0);
+  polygon_t *outline = polygon_init(CIRCLE_OUTLINE_POINTS);
+  for (size_t i = 0; i < CIRCLE_OUTLINE_POINTS; i++) {
+    double angle = 2 * M_PI * i / CIRCLE_OUTLINE_POINTS;
+    vector_t offset = {radius * cos(angle), radius * sin(angle)};
+    polygon_add_vertex(outline, vec_add(center, offset));
+  }
+  body_t *body = body_init_polygon(NULL, outline, mass, color, NULL, NULL);
+  body->radius = radius;
+  // A uniform disc, about its center
+  body->moment_of_inertia = 0.5 * mass * radius * radius;
+  body->curr_moment_of_inertia = body->moment_of_inertia;
   body->info = info;
   body->info_freer = info_freer;
   return body;
 }
 
+bool body_is_circle(body_t *body) { return body->radius > 0.0; }
+
+double body_get_radius(body_t *body) { return body->radius; }
+
+body_t *body_init_kinematic(list_t *shape, rgb_color_t color) {
+  body_t *body = body_init(shape, INFINITY, color);
+  body->motion_type = MOTION_KINEMATIC;
+  return body;
+}
+
+body_t *body_init_decoration(list_t *shape, rgb_color_t color) {
+  return body_init_decoration_in(NULL, shape, color);
+}
+
+body_t *body_init_decoration_in(arena_t *arena, list_t *shape,
+                                rgb_color_t color) {
+  body_t *body =
+      body_init_with_info_in(arena, shape, INFINITY, color, NULL, NULL);
+  body->motion_type = MOTION_STATIC;
+  body->decoration = true;
+  return body;
+}
+
+motion_type_t body_get_motion_type(body_t *body) { return body->motion_type; }
+
+size_t body_get_shape_version(body_t *body) { return body->shape_version; }
+
+bool body_is_decoration(body_t *body) { return body->decoration; }
+
+void body_set_bullet(body_t *body, bool bullet) { body->bullet = bullet; }
+
+bool body_is_bullet(body_t *body) { return body->bullet; }
+
 void body_free(body_t *body) {
-  list_free(body->polygon);
+  polygon_free(body->local_polygon);
+  polygon_free(body->polygon);
+  if (body->local_normals != NULL) {
+    polygon_free(body->local_normals);
+  }
+  polygon_free(body->normals);
+  body_release(body, body->extremes);
+  body_free_parts(body);
+  if (body->heightfield != NULL) {
+    heightfield_free(body->heightfield);
+  }
+  if (body->chain != NULL) {
+    chain_free(body->chain);
+  }
   if (body->info_freer != NULL) {
     body->info_freer(body->info);
   }
-  free(body);
+  list_free(body->forces);
+  body_release(body, body);
 }
 
 list_t *body_get_shape(body_t *body) {
-  list_t *shape = list_init(list_size(body->polygon), free);
-  for (size_t i = 0; i < list_size(body->polygon); i++) {
-    vector_t vector = *((vector_t *)list_get(body->polygon, i));
-    vector_t *added_vector = malloc(sizeof(vector_t));
-    assert(added_vector != NULL);
-    *added_vector = vector;
-    list_add(shape, added_vector);
+  return polygon_to_list(body_get_polygon(body));
+}
+
+aabb_t body_get_bounds(body_t *body) { return body->bounds; }
+
+vector_t body_get_bounding_center(body_t *body) { return body->origin; }
+
+double body_get_bounding_radius(body_t *body) { return body->bounding_radius; }
+
+const polygon_t *body_get_polygon(body_t *body) {
+  if (body->shape_dirty) {
+    polygon_transform(body->polygon, body->local_polygon, body->angle,
+                      body->origin);
+    body->shape_dirty = false;
+  }
+  return body->polygon;
+}
+
+const polygon_t *body_get_normals(body_t *body) {
+  body_ensure_local_normals(body);
+  if (body->normals_angle != body->angle) {
+    polygon_transform(body->normals, body->local_normals, body->angle,
+                      VEC_ZERO);
+    body->normals_angle = body->angle;
+  }
+  return body->normals;
+}
+
+void body_set_collision_tolerance(body_t *body, double tolerance) {
+  if (tolerance == body->collision_tolerance) {
+    return;
+  }
+  body->collision_tolerance = tolerance;
+  body->local_parts_dirty = true;
+  // The body now collides as a different shape, so cached results are stale
+  body->shape_version++;
+}
+
+size_t body_get_num_parts(body_t *body) {
+  body_ensure_local_parts(body);
+  return body->num_parts > 0 ? body->num_parts : 1;
+}
+
+const polygon_t *body_get_part(body_t *body, size_t index) {
+  body_ensure_local_parts(body);
+  if (body->num_parts == 0) {
+    assert(index == 0);
+    return body_get_polygon(body);
   }
-  return shape;
+  assert(index < body->num_parts);
+  body_update_parts(body);
+  return body->parts[index].polygon;
+}
+
+const chain_t *body_get_chain(body_t *body) { return body->chain; }
+
+vector_t body_shape_to_world(body_t *body, vector_t point) {
+  vector_t local = vec_subtract(point, body->shape_offset);
+  return vec_add(vec_rotate(local, body->angle), body->origin);
+}
+
+vector_t body_world_to_shape(body_t *body, vector_t point) {
+  vector_t local = vec_rotate(vec_subtract(point, body->origin), -body->angle);
+  return vec_add(local, body->shape_offset);
+}
+
+void body_find_parts(body_t *body, aabb_t bounds, size_t *first,
+                     size_t *end) {
+  body_ensure_local_parts(body);
+  if (body->heightfield == NULL || body->angle != 0.0) {
+    *first = 0;
+    *end = body_get_num_parts(body);
+    return;
+  }
+  // Unrotated, world x is heightfield x - shape_offset.x + origin.x
+  double shift = body->shape_offset.x - body->origin.x;
+  heightfield_find_columns(body->heightfield, bounds.min.x + shift,
+                           bounds.max.x + shift, first, end);
+}
+
+const polygon_t *body_get_part_normals(body_t *body, size_t index) {
+  body_ensure_local_parts(body);
+  if (body->num_parts == 0) {
+    assert(index == 0);
+    return body_get_normals(body);
+  }
+  assert(index < body->num_parts);
+  body_update_parts(body);
+  return body->parts[index].normals;
+}
+
+const size_t *body_get_part_extremes(body_t *body, size_t index) {
+  body_ensure_local_parts(body);
+  if (body->num_parts == 0) {
+    assert(index == 0);
+    body_ensure_local_normals(body);
+    return body->extremes;
+  }
+  assert(index < body->num_parts);
+  return body->parts[index].extremes;
 }
 
 vector_t body_get_centroid(body_t *body) { return (body->centroid); }
@@ -103,41 +589,66 @@ rgb_color_t body_get_color(body_t *body) { return (body->color); }
 
 void *body_get_info(body_t *body) { return body->info; }
 
+list_t *body_get_forces(body_t *body) { return body->forces; }
+
+size_t body_get_proxy_index(body_t *body) { return body->proxy_index; }
+
+void body_set_proxy_index(body_t *body, size_t index) {
+  body->proxy_index = index;
+}
+
 void body_set_centroid(body_t *body, vector_t x) {
-  polygon_translate(body->polygon, vec_subtract(x, body->centroid));
-  body->curr_pivot_point =
-      vec_add(body->curr_pivot_point, vec_subtract(x, body->centroid));
+  if (x.x == body->centroid.x && x.y == body->centroid.y) {
+    return;
+  }
+  vector_t displacement = vec_subtract(x, body->centroid);
+  body->origin = vec_add(body->origin, displacement);
+  body->curr_pivot_point = vec_add(body->curr_pivot_point, displacement);
   body->centroid = x;
+  body->shape_dirty = true;
+  body_update_bounds(body);
 }
 
 void body_set_velocity(body_t *body, vector_t v) { body->velocity = v; }
 
 void body_set_acceleration(body_t *body, vector_t a) { body->acceleration = a; }
 
+// Rotates the body's local frame about a point without moving its centroid
+void body_rotate_about(body_t *body, double angle, vector_t point) {
+  if (angle == 0.0) {
+    return;
+  }
+  vector_t offset = vec_subtract(body->origin, point);
+  body->origin = vec_add(vec_rotate(offset, angle), point);
+  body->angle += angle;
+  body->shape_dirty = true;
+  body_update_bounds(body);
+}
+
 void body_set_rotation(body_t *body, double angle) {
-  double angle_diff = angle - body->angle;
-  polygon_rotate(body->polygon, angle_diff, body->centroid);
-  // polygon_rotate(body->polygon, angle_diff, body->curr_pivot_point);
+  body_rotate_about(body, angle - body->angle, body->centroid);
   body->angle = angle;
 }
 
 void body_rotate(body_t *body, double angle) {
-  polygon_rotate(body->polygon, angle, body->curr_pivot_point);
-  // vector_t new_reference = vec_subtract(*body->reference_pointer,
-  // body->centroid); body->angle = vec_angle(new_reference) -
-  // vec_angle(body->reference_vector);
-  body->angle += angle;
+  body_rotate_about(body, angle, body->curr_pivot_point);
 }
 
 double body_get_rotation(body_t *body) { return body->angle; }
 
 void body_add_force(body_t *body, vector_t force) {
+  if (body->motion_type != MOTION_DYNAMIC) {
+    return;
+  }
   body->force = vec_add(body->force, force);
 }
 
 vector_t body_get_force(body_t *body) { return body->force; }
 
 void body_add_impulse(body_t *body, vector_t impulse) {
+  if (body->motion_type != MOTION_DYNAMIC) {
+    return;
+  }
   body->impulse = vec_add(body->impulse, impulse);
 }
 
@@ -160,10 +671,16 @@ void body_increment_angular_velocity(body_t *body, double increment) {
 }
 
 void body_add_torque(body_t *body, double torque) {
+  if (body->motion_type != MOTION_DYNAMIC) {
+    return;
+  }
   body->torque = body->torque + torque;
 }
 
 void body_add_angular_impulse(body_t *body, double angular_impulse) {
+  if (body->motion_type != MOTION_DYNAMIC) {
+    return;
+  }
   body->angular_impulse = body->angular_impulse + angular_impulse;
 }
 
@@ -204,6 +721,15 @@ void body_reset_pivot(body_t *body) {
 }
 
 void body_tick(body_t *body, double dt) {
+  if (body->motion_type == MOTION_STATIC) {
+    return;
+  }
+  if (body->motion_type == MOTION_KINEMATIC) {
+    body_set_centroid(body, vec_add(body->centroid,
+                                    vec_multiply(dt, body->velocity)));
+    body_rotate(body, body->angular_velocity * dt);
+    return;
+  }
   body->acceleration = vec_multiply(1 / body->mass, body->force);
   vector_t final_velocity = get_final_velocity(body, dt);
   vector_t new_centroid =
@@ -235,6 +761,32 @@ void body_remove(body_t *body) { body->removed = 1; }
 bool body_is_removed(body_t *body) { return body->removed; }
 
 void body_set_polygon(body_t *body, list_t *polygon) {
-  list_free(body->polygon);
-  body->polygon = polygon;
+  polygon_free(body->polygon);
+  body->polygon = polygon_from_list(polygon);
+  list_free(polygon);
+  body->shape_dirty = false;
+  // Store the new vertices relative to the current transform
+  polygon_transform(body->local_polygon, body->polygon, -body->angle,
+                    vec_rotate(vec_negate(body->origin), -body->angle));
+  // The normals and parts are found again when a collision needs them
+  if (body->local_normals != NULL) {
+    polygon_free(body->local_normals);
+    body->local_normals = NULL;
+  }
+  body_release(body, body->extremes);
+  body->extremes = NULL;
+  // The new polygon replaces any circle, heightfield or chain as the
+  // collision shape
+  body->radius = 0.0;
+  if (body->heightfield != NULL) {
+    heightfield_free(body->heightfield);
+    body->heightfield = NULL;
+  }
+  if (body->chain != NULL) {
+    chain_free(body->chain);
+    body->chain = NULL;
+  }
+  body->local_parts_dirty = true;
+  body_update_local_bounds(body);
+  body_update_bounds(body);
 }
\ No newline at end of file
@@ -0,0 +1,168 @@
+#include "chain.h"
+#include "list.h"
+#include "polygon.h"
+#include "vector.h"
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+
+// most segments kept in one leaf of the hierarchy
+const size_t CHAIN_LEAF_SEGMENTS = 4;
+// deepest a hierarchy can be; each level halves the segments, so this is
+// never reached
+#define CHAIN_MAX_DEPTH 64
+
+// A node of the hierarchy, covering segments first to end - 1. Consecutive
+// segments are joined end to end, so they are close together. A leaf has
+// right == 0; otherwise its children are the nodes after it and at right.
+typedef struct chain_node {
+  aabb_t bounds;
+  size_t first;
+  size_t end;
+  size_t right;
+} chain_node_t;
+
+typedef struct chain {
+  polygon_t *vertices;
+  size_t num_segments;
+  // the unit normal of each segment, and the average normal at each vertex
+  vector_t *normals;
+  vector_t *vertex_normals;
+  chain_node_t *nodes;
+  size_t num_nodes;
+} chain_t;
+
+aabb_t aabb_union(aabb_t box1, aabb_t box2) {
+  return (aabb_t){.min = {fmin(box1.min.x, box2.min.x),
+                          fmin(box1.min.y, box2.min.y)},
+                  .max = {fmax(box1.max.x, box2.max.x),
+                          fmax(box1.max.y, box2.max.y)}};
+}
+
+aabb_t chain_segment_bounds(const chain_t *chain, size_t index) {
+  vector_t start, end;
+  chain_get_segment(chain, index, &start, &end);
+  return (aabb_t){.min = {fmin(start.x, end.x), fmin(start.y, end.y)},
+                  .max = {fmax(start.x, end.x), fmax(start.y, end.y)}};
+}
+
+// Builds the node at index for segments first to end - 1 and its subtree,
+// returning the index of the next unused node
+size_t chain_build_node(chain_t *chain, size_t index, size_t first,
+                        size_t end) {
+  chain_node_t *node = &chain->nodes[index];
+  node->first = first;
+  node->end = end;
+  if (end - first <= CHAIN_LEAF_SEGMENTS) {
+    node->right = 0;
+    node->bounds = chain_segment_bounds(chain, first);
+    for (size_t i = first + 1; i < end; i++) {
+      node->bounds = aabb_union(node->bounds, chain_segment_bounds(chain, i));
+    }
+    return index + 1;
+  }
+  size_t middle = first + (end - first) / 2;
+  node->right = chain_build_node(chain, index + 1, first, middle);
+  size_t next = chain_build_node(chain, node->right, middle, end);
+  node->bounds = aabb_union(chain->nodes[index + 1].bounds,
+                            chain->nodes[node->right].bounds);
+  return next;
+}
+
+chain_t *chain_init(list_t *vertices, bool closed) {
+  size_t size = list_size(vertices);
+  assert(size >= (closed ? 3 : 2));
+  chain_t *chain = malloc(sizeof(chain_t));
+  assert(chain != NULL);
+  chain->vertices = polygon_from_list(vertices);
+  list_free(vertices);
+  chain->num_segments = closed ? size : size - 1;
+  chain->normals = malloc(sizeof(vector_t) * (chain->num_segments + size));
+  assert(chain->normals != NULL);
+  chain->vertex_normals = chain->normals + chain->num_segments;
+  for (size_t i = 0; i < chain->num_segments; i++) {
+    vector_t start, end;
+    chain_get_segment(chain, i, &start, &end);
+    double length = vec_magn(vec_subtract(end, start));
+    assert(length > 0);
+    chain->normals[i] =
+        vec_multiply(1 / length, vec_normal(vec_subtract(end, start)));
+  }
+  for (size_t i = 0; i < size; i++) {
+    // The segments that end and start at vertex i, if there are any
+    bool has_before = closed || i > 0;
+    bool has_after = closed || i < size - 1;
+    vector_t before = chain->normals[has_before ? (i + size - 1) % size : i];
+    vector_t after = chain->normals[has_after ? i : i - 1];
+    vector_t sum = vec_add(before, after);
+    double length = vec_magn(sum);
+    // Opposite normals (a hairpin) have no average
+    chain->vertex_normals[i] =
+        length > 1e-9 ? vec_multiply(1 / length, sum) : after;
+  }
+  // A binary tree with at most CHAIN_LEAF_SEGMENTS per leaf
+  chain->nodes = malloc(sizeof(chain_node_t) * 2 * chain->num_segments);
+  assert(chain->nodes != NULL);
+  chain->num_nodes = chain_build_node(chain, 0, 0, chain->num_segments);
+  return chain;
+}
+
+void chain_free(chain_t *chain) {
+  polygon_free(chain->vertices);
+  free(chain->normals);
+  free(chain->nodes);
+  free(chain);
+}
+
+size_t chain_num_segments(const chain_t *chain) { return chain->num_segments; }
+
+aabb_t chain_get_bounds(const chain_t *chain) {
+  return polygon_get_bounds(chain->vertices);
+}
+
+void chain_get_segment(const chain_t *chain, size_t index, vector_t *start,
+                       vector_t *end) {
+  assert(index < chain->num_segments);
+  size_t next = index + 1 < polygon_size(chain->vertices) ? index + 1 : 0;
+  *start = polygon_get_vertex(chain->vertices, index);
+  *end = polygon_get_vertex(chain->vertices, next);
+}
+
+vector_t chain_get_segment_normal(const chain_t *chain, size_t index) {
+  assert(index < chain->num_segments);
+  return chain->normals[index];
+}
+
+vector_t chain_get_vertex_normal(const chain_t *chain, size_t index) {
+  size_t size = polygon_size(chain->vertices);
+  assert(index <= size);
+  return chain->vertex_normals[index % size];
+}
+
+void chain_query(const chain_t *chain, aabb_t box, chain_visitor_t visitor,
+                 void *aux) {
+  size_t stack[CHAIN_MAX_DEPTH];
+  size_t depth = 0;
+  stack[depth++] = 0;
+  while (depth > 0) {
+    const chain_node_t *node = &chain->nodes[stack[--depth]];
+    if (!aabb_overlaps(node->bounds, box)) {
+      continue;
+    }
+    if (node->right != 0) {
+      assert(depth + 2 <= CHAIN_MAX_DEPTH);
+      stack[depth++] = node->right;
+      stack[depth++] = node - chain->nodes + 1;
+      continue;
+    }
+    for (size_t i = node->first; i < node->end; i++) {
+      if (aabb_overlaps(chain_segment_bounds(chain, i), box)) {
+        visitor(i, aux);
+      }
+    }
+  }
+}
+
+polygon_t *chain_get_outline(const chain_t *chain) {
+  return polygon_copy(chain->vertices);
+}
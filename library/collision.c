@@ -1,5 +1,6 @@
 #include "collision.h"
 #include "body.h"
+#include "chain.h"
 #include "forces.h"
 #include "polygon.h"
 #include "scene.h"
@@ -8,74 +9,1094 @@
 #include <math.h>
 #include <stdlib.h>
 
-list_t *get_normals(list_t *edges1, list_t *edges2) {
-  size_t len1 = list_size(edges1);
-  size_t len2 = list_size(edges2);
-  size_t len_total = len1 + len2;
-  list_t *result = list_init(len_total, free);
-  for (size_t i = 0; i < len_total; i++) {
-    vector_t *normal = malloc(sizeof(vector_t));
-    assert(normal != NULL);
-    if (i < len1) {
-      *normal = vec_normal(*(vector_t *)list_get(edges1, i));
+typedef struct contact {
+  body_t *body1;
+  body_t *body2;
+  size_t references;
+  // whether the contact was allocated with contact_init_in()
+  bool pooled;
+  // whether info is the result for the shape versions below
+  bool valid;
+  size_t version1;
+  size_t version2;
+  collision_info_t info;
+  // the axis that last separated the bodies, tried first next time, or
+  // VEC_ZERO if there is none
+  vector_t separating_axis;
+} contact_t;
+
+// most iterations GJK and EPA each take; on polygons both converge long
+// before, after about as many iterations as the shapes' vertices near the
+// closest points
+const size_t GJK_MAX_ITERATIONS = 64;
+// most vertices EPA grows its polygon to
+#define EPA_MAX_VERTICES 64
+// GJK and EPA stop once an iteration gets closer by less than this fraction
+const double GJK_TOLERANCE = 1e-10;
+// squared distances below this count as the origin being on GJK's simplex
+const double GJK_EPSILON = 1e-18;
+
+// counters for contact_get_collision()'s separating axis cache
+axis_cache_stats_t axis_cache_stats = {.lookups = 0, .hits = 0};
+
+double min(double a, double b) { return a < b ? a : b; }
+
+// The axis of least overlap found so far by a separating axis test
+typedef struct overlap {
+  double depth;
+  vector_t axis;
+  // whether axis is an edge normal of shape2 rather than shape1
+  bool from_shape2;
+  // whether shape2 lies on the side of shape1 that axis points towards
+  bool forward;
+  // if the shapes turned out to be separated, an axis that separates them
+  vector_t separating_axis;
+} overlap_t;
+
+// The vertices of two convex shapes that projected furthest back and forward
+// onto the last axis tested. Consecutive edge normals turn a little at a
+// time, so the next axis's extremes are found by climbing from these.
+typedef struct projection_hints {
+  size_t min1;
+  size_t max1;
+  size_t min2;
+  size_t max2;
+} projection_hints_t;
+
+// Tests whether normal separates shape1 and shape2. Projections are taken as
+// raw dot products and divided by the normal's magnitude afterwards, which
+// yields the same bounds as vec_scalar_project() on every vertex as long as
+// neither is fused into FMAs (the Makefile turns that off). If hints is
+// non-NULL, the shapes are convex and their extreme vertices are searched for
+// from the hints. Returns false if the shapes are separated; otherwise
+// records the axis if it has the least overlap so far.
+bool check_axis(vector_t normal, double magnitude, bool from_shape2,
+                const polygon_t *shape1, const polygon_t *shape2,
+                projection_hints_t *hints, overlap_t *best) {
+  double min1, max1, min2, max2;
+  if (hints != NULL) {
+    polygon_project_convex(shape1, normal, &hints->min1, &hints->max1, &min1,
+                           &max1);
+    polygon_project_convex(shape2, normal, &hints->min2, &hints->max2, &min2,
+                           &max2);
+  } else {
+    polygon_project(shape1, normal, &min1, &max1);
+    polygon_project(shape2, normal, &min2, &max2);
+  }
+  min1 /= magnitude;
+  max1 /= magnitude;
+  min2 /= magnitude;
+  max2 /= magnitude;
+  if ((min1 > max2) || (max1 < min2)) {
+    best->separating_axis = normal;
+    return false;
+  }
+  double curr_difference = min(fabs(min1 - max2), fabs(min2 - max1));
+  if (best->depth > curr_difference) {
+    best->depth = curr_difference;
+    best->axis = normal;
+    best->from_shape2 = from_shape2;
+    best->forward = fabs(min2 - max1) <= fabs(min1 - max2);
+  }
+  return true;
+}
+
+// Tests the edge normals of shape1 (or shape2, if from_shape2) as separating
+// axes, computing each normal from the edge
+bool check_edge_normals(bool from_shape2, const polygon_t *shape1,
+                        const polygon_t *shape2, overlap_t *best) {
+  const polygon_t *edge_shape = from_shape2 ? shape2 : shape1;
+  const double *xs = polygon_get_xs(edge_shape);
+  const double *ys = polygon_get_ys(edge_shape);
+  size_t size = polygon_size(edge_shape);
+  for (size_t i = 0; i < size; i++) {
+    size_t next = i + 1 < size ? i + 1 : 0;
+    vector_t edge = {xs[next] - xs[i], ys[next] - ys[i]};
+    vector_t normal = vec_normal(edge);
+    if (!check_axis(normal, vec_magn(normal), from_shape2, shape1, shape2,
+                    NULL, best)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Tests precomputed unit normals of shape1 (or shape2, if from_shape2) as
+// separating axes. The shapes are convex, and extremes holds the extreme
+// vertices of the normals' own shape along each normal, if known.
+bool check_unit_normals(const polygon_t *normals, const size_t *extremes,
+                        bool from_shape2, const polygon_t *shape1,
+                        const polygon_t *shape2, projection_hints_t *hints,
+                        overlap_t *best) {
+  const double *xs = polygon_get_xs(normals);
+  const double *ys = polygon_get_ys(normals);
+  for (size_t i = 0; i < polygon_size(normals); i++) {
+    if (extremes != NULL) {
+      // Start the normals' own shape at the answer
+      *(from_shape2 ? &hints->min2 : &hints->min1) = extremes[2 * i];
+      *(from_shape2 ? &hints->max2 : &hints->max1) = extremes[2 * i + 1];
+    }
+    if (!check_axis((vector_t){xs[i], ys[i]}, 1.0, from_shape2, shape1,
+                    shape2, hints, best)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Finds the edge of shape that faces furthest along direction: the more
+// perpendicular of the two edges at the vertex with the largest projection
+void find_support_edge(const polygon_t *shape, vector_t direction,
+                       vector_t *start, vector_t *end) {
+  const double *xs = polygon_get_xs(shape);
+  const double *ys = polygon_get_ys(shape);
+  size_t size = polygon_size(shape);
+  size_t support = 0;
+  for (size_t i = 1; i < size; i++) {
+    if (xs[i] * direction.x + ys[i] * direction.y >
+        xs[support] * direction.x + ys[support] * direction.y) {
+      support = i;
+    }
+  }
+  vector_t vertex = polygon_get_vertex(shape, support);
+  vector_t prev = polygon_get_vertex(shape, (support + size - 1) % size);
+  vector_t next = polygon_get_vertex(shape, (support + 1) % size);
+  vector_t to_prev = vec_subtract(prev, vertex);
+  vector_t to_next = vec_subtract(next, vertex);
+  // |cos| of each edge's angle with direction, compared without a sqrt
+  double prev_dot = vec_dot(to_prev, direction);
+  double next_dot = vec_dot(to_next, direction);
+  if (prev_dot * prev_dot * vec_dot(to_next, to_next) <
+      next_dot * next_dot * vec_dot(to_prev, to_prev)) {
+    *start = prev;
+    *end = vertex;
+  } else {
+    *start = vertex;
+    *end = next;
+  }
+}
+
+// Cuts the segment from *point1 to *point2 down to where dot(p, direction)
+// is at least offset, unless it lies entirely below offset
+void clip_segment(vector_t *point1, vector_t *point2, vector_t direction,
+                  double offset) {
+  double distance1 = vec_dot(*point1, direction) - offset;
+  double distance2 = vec_dot(*point2, direction) - offset;
+  if ((distance1 < 0) == (distance2 < 0)) {
+    return;
+  }
+  vector_t crossing = vec_add(
+      *point1, vec_multiply(distance1 / (distance1 - distance2),
+                            vec_subtract(*point2, *point1)));
+  if (distance1 < 0) {
+    *point1 = crossing;
+  } else {
+    *point2 = crossing;
+  }
+}
+
+// Fills in the penetration depth and contact points of overlapping convex
+// shapes. The shape that owns the axis gives the reference edge; the other
+// shape's incident edge is clipped to the reference edge's extent, and the
+// clipped points that lie behind the reference edge are the contacts.
+void find_contact_points(const polygon_t *shape1, const polygon_t *shape2,
+                         overlap_t overlap, collision_info_t *result) {
+  const polygon_t *reference = overlap.from_shape2 ? shape2 : shape1;
+  const polygon_t *incident = overlap.from_shape2 ? shape1 : shape2;
+  // normal points from the reference shape towards the incident shape
+  vector_t normal = vec_multiply(1 / vec_magn(overlap.axis), overlap.axis);
+  if (overlap.forward == overlap.from_shape2) {
+    normal = vec_negate(normal);
+  }
+  vector_t reference_start, reference_end, point1, point2;
+  find_support_edge(reference, normal, &reference_start, &reference_end);
+  find_support_edge(incident, vec_negate(normal), &point1, &point2);
+  vector_t tangent = vec_subtract(reference_end, reference_start);
+  double length = vec_magn(tangent);
+  tangent = length > 0 ? vec_multiply(1 / length, tangent) : vec_normal(normal);
+  clip_segment(&point1, &point2, tangent, vec_dot(reference_start, tangent));
+  clip_segment(&point1, &point2, vec_negate(tangent),
+               -vec_dot(reference_end, tangent));
+  double face = fmax(vec_dot(reference_start, normal),
+                     vec_dot(reference_end, normal));
+  double depth1 = face - vec_dot(point1, normal);
+  double depth2 = face - vec_dot(point2, normal);
+  result->depth = overlap.depth;
+  result->num_contacts = 0;
+  // Deepest point first
+  if (depth2 > depth1) {
+    vector_t point = point1;
+    point1 = point2;
+    point2 = point;
+    double depth = depth1;
+    depth1 = depth2;
+    depth2 = depth;
+  }
+  if (depth1 >= 0) {
+    result->contacts[result->num_contacts++] = point1;
+  }
+  if (depth2 >= 0) {
+    result->contacts[result->num_contacts++] = point2;
+  }
+  // Rounding can leave both points a hair in front of the reference edge
+  if (result->num_contacts == 0) {
+    result->contacts[result->num_contacts++] = point1;
+  }
+}
+
+collision_info_t find_polygon_collision(const polygon_t *shape1,
+                                        const polygon_t *shape2) {
+  collision_info_t result = {.collided = false, .axis = VEC_ZERO};
+  if (!aabb_overlaps(polygon_get_bounds(shape1), polygon_get_bounds(shape2))) {
+    return result;
+  }
+  overlap_t overlap = {.depth = INFINITY, .axis = VEC_ZERO};
+  if (!check_edge_normals(false, shape1, shape2, &overlap) ||
+      !check_edge_normals(true, shape1, shape2, &overlap)) {
+    return result;
+  }
+  result.collided = true;
+  result.axis = overlap.axis;
+  find_contact_points(shape1, shape2, overlap, &result);
+  return result;
+}
+
+collision_info_t find_collision(list_t *shape1, list_t *shape2) {
+  polygon_t *polygon1 = polygon_from_list(shape1);
+  polygon_t *polygon2 = polygon_from_list(shape2);
+  collision_info_t result = find_polygon_collision(polygon1, polygon2);
+  polygon_free(polygon1);
+  polygon_free(polygon2);
+  return result;
+}
+
+// Whether axis separates the projections of shape1 and shape2
+bool axis_separates(vector_t axis, const polygon_t *shape1,
+                    const polygon_t *shape2) {
+  double min1, max1, min2, max2;
+  polygon_project(shape1, axis, &min1, &max1);
+  polygon_project(shape2, axis, &min2, &max2);
+  return min1 > max2 || max1 < min2;
+}
+
+// Runs SAT on two convex shapes with precomputed unit normals, and the
+// shapes' extreme vertices along them (see body_get_part_extremes()) if
+// known. Returns whether they overlap, and if so the axis of least overlap;
+// otherwise overlap->separating_axis is an axis that separates them, or
+// VEC_ZERO if their bounding boxes are apart.
+bool find_convex_overlap(const polygon_t *shape1, const polygon_t *normals1,
+                         const size_t *extremes1, const polygon_t *shape2,
+                         const polygon_t *normals2, const size_t *extremes2,
+                         overlap_t *overlap) {
+  *overlap = (overlap_t){.depth = INFINITY,
+                         .axis = VEC_ZERO,
+                         .separating_axis = VEC_ZERO};
+  if (!aabb_overlaps(polygon_get_bounds(shape1), polygon_get_bounds(shape2))) {
+    return false;
+  }
+  projection_hints_t hints = {.min1 = 0, .max1 = 0, .min2 = 0, .max2 = 0};
+  return check_unit_normals(normals1, extremes1, false, shape1, shape2,
+                            &hints, overlap) &&
+         check_unit_normals(normals2, extremes2, true, shape1, shape2, &hints,
+                            overlap);
+}
+
+// The deepest contact found so far between a chain body's segments and one
+// convex part of another body. The chain is placed in the world by rotating
+// it by the angle whose cosine and sine are given, then translating it.
+typedef struct chain_contact {
+  const chain_t *chain;
+  double cos_angle;
+  double sin_angle;
+  vector_t translation;
+  const polygon_t *part;
+  const polygon_t *part_normals;
+  // if the other body is a circle, its center and radius instead of part
+  vector_t center;
+  double radius;
+  bool found;
+  double depth;
+  vector_t normal;
+  vector_t point;
+} chain_contact_t;
+
+// Rotates a vector of the chain's into the world's orientation
+vector_t chain_contact_rotate(const chain_contact_t *contact, vector_t v) {
+  return (vector_t){v.x * contact->cos_angle - v.y * contact->sin_angle,
+                    v.x * contact->sin_angle + v.y * contact->cos_angle};
+}
+
+// Places a segment of the chain in a chain_contact_t in the world, with its
+// normal
+void chain_contact_get_segment(const chain_contact_t *contact, size_t segment,
+                               vector_t *start, vector_t *end,
+                               vector_t *normal) {
+  const chain_t *chain = contact->chain;
+  chain_get_segment(chain, segment, start, end);
+  *start = vec_add(chain_contact_rotate(contact, *start), contact->translation);
+  *end = vec_add(chain_contact_rotate(contact, *end), contact->translation);
+  *normal =
+      chain_contact_rotate(contact, chain_get_segment_normal(chain, segment));
+}
+
+// Checks one segment of a chain against the part in a chain_contact_t. The
+// part must overlap the segment and have its center in front of it; it is
+// then pushed out along the segment's normal, or the vertex normal if its
+// deepest vertex is beyond an end of the segment.
+void check_chain_segment(size_t segment, void *aux) {
+  chain_contact_t *contact = aux;
+  const chain_t *chain = contact->chain;
+  vector_t start, end, normal;
+  chain_contact_get_segment(contact, segment, &start, &end, &normal);
+  aabb_t bounds = polygon_get_bounds(contact->part);
+  vector_t center = vec_multiply(0.5, vec_add(bounds.min, bounds.max));
+  double face = vec_dot(start, normal);
+  if (vec_dot(center, normal) < face) {
+    return;
+  }
+  double min, max;
+  polygon_project(contact->part, normal, &min, &max);
+  if (min > face) {
+    return;
+  }
+  const double *normal_xs = polygon_get_xs(contact->part_normals);
+  const double *normal_ys = polygon_get_ys(contact->part_normals);
+  for (size_t i = 0; i < polygon_size(contact->part_normals); i++) {
+    vector_t axis = {normal_xs[i], normal_ys[i]};
+    polygon_project(contact->part, axis, &min, &max);
+    double start_dot = vec_dot(start, axis);
+    double end_dot = vec_dot(end, axis);
+    if (min > fmax(start_dot, end_dot) || max < fmin(start_dot, end_dot)) {
+      return;
+    }
+  }
+  // The vertex furthest behind the segment's line
+  const double *xs = polygon_get_xs(contact->part);
+  const double *ys = polygon_get_ys(contact->part);
+  size_t deepest = 0;
+  for (size_t i = 1; i < polygon_size(contact->part); i++) {
+    if (xs[i] * normal.x + ys[i] * normal.y <
+        xs[deepest] * normal.x + ys[deepest] * normal.y) {
+      deepest = i;
+    }
+  }
+  vector_t point = {xs[deepest], ys[deepest]};
+  double depth = face - vec_dot(point, normal);
+  if (contact->found && depth <= contact->depth) {
+    return;
+  }
+  // Past either end of the segment, the vertex there gives the normal
+  vector_t along = vec_subtract(end, start);
+  double t = vec_dot(vec_subtract(point, start), along);
+  if (t <= 0) {
+    normal =
+        chain_contact_rotate(contact, chain_get_vertex_normal(chain, segment));
+  } else if (t >= vec_dot(along, along)) {
+    normal = chain_contact_rotate(contact,
+                                  chain_get_vertex_normal(chain, segment + 1));
+  }
+  contact->found = true;
+  contact->depth = depth;
+  contact->normal = normal;
+  contact->point = point;
+}
+
+// Checks one segment of a chain against the circle in a chain_contact_t. The
+// circle must have its center in front of the segment and within its radius
+// of the closest point of the segment, and is pushed out like a part in
+// check_chain_segment().
+void check_chain_circle(size_t segment, void *aux) {
+  chain_contact_t *contact = aux;
+  vector_t start, end, normal;
+  chain_contact_get_segment(contact, segment, &start, &end, &normal);
+  double height = vec_dot(vec_subtract(contact->center, start), normal);
+  if (height < 0 || height > contact->radius) {
+    return;
+  }
+  vector_t along = vec_subtract(end, start);
+  double t = vec_dot(vec_subtract(contact->center, start), along) /
+             vec_dot(along, along);
+  t = fmin(fmax(t, 0.0), 1.0);
+  vector_t point = vec_add(start, vec_multiply(t, along));
+  double depth =
+      contact->radius - vec_magn(vec_subtract(contact->center, point));
+  if (depth < 0 || (contact->found && depth <= contact->depth)) {
+    return;
+  }
+  if (t == 0.0) {
+    normal = chain_contact_rotate(
+        contact, chain_get_vertex_normal(contact->chain, segment));
+  } else if (t == 1.0) {
+    normal = chain_contact_rotate(
+        contact, chain_get_vertex_normal(contact->chain, segment + 1));
+  }
+  contact->found = true;
+  contact->depth = depth;
+  contact->normal = normal;
+  contact->point = point;
+}
+
+// Collides a chain body with another body, part by part
+collision_info_t find_chain_collision(body_t *body1, body_t *body2) {
+  collision_info_t result = {.collided = false, .axis = VEC_ZERO};
+  bool chain_first = body_get_chain(body1) != NULL;
+  body_t *chain_body = chain_first ? body1 : body2;
+  body_t *other = chain_first ? body2 : body1;
+  if (body_get_chain(other) != NULL) {
+    return result;
+  }
+  double angle = body_get_rotation(chain_body);
+  chain_contact_t contact = {
+      .chain = body_get_chain(chain_body),
+      .cos_angle = cos(angle),
+      .sin_angle = sin(angle),
+      .translation = body_shape_to_world(chain_body, VEC_ZERO),
+      .center = body_get_centroid(other),
+      .radius = body_get_radius(other),
+      .found = false};
+  // A circle's one part is its outline, whose bounds are the circle's
+  chain_visitor_t visitor =
+      body_is_circle(other) ? check_chain_circle : check_chain_segment;
+  aabb_t chain_bounds = body_get_bounds(chain_body);
+  size_t first, end;
+  body_find_parts(other, chain_bounds, &first, &end);
+  for (size_t i = first; i < end; i++) {
+    contact.part = body_get_part(other, i);
+    aabb_t bounds = polygon_get_bounds(contact.part);
+    if (!aabb_overlaps(bounds, chain_bounds)) {
+      continue;
+    }
+    contact.part_normals = body_get_part_normals(other, i);
+    // The chain's hierarchy is searched in the chain's own coordinates
+    aabb_t query = bounds;
+    if (angle != 0.0) {
+      query = (aabb_t){.min = {INFINITY, INFINITY},
+                       .max = {-INFINITY, -INFINITY}};
+      vector_t corners[] = {bounds.min,
+                            {bounds.max.x, bounds.min.y},
+                            bounds.max,
+                            {bounds.min.x, bounds.max.y}};
+      for (size_t j = 0; j < 4; j++) {
+        vector_t corner = body_world_to_shape(chain_body, corners[j]);
+        query.min = (vector_t){fmin(query.min.x, corner.x),
+                               fmin(query.min.y, corner.y)};
+        query.max = (vector_t){fmax(query.max.x, corner.x),
+                               fmax(query.max.y, corner.y)};
+      }
     } else {
-      *normal = vec_normal(*(vector_t *)list_get(edges2, i - len1));
+      query.min = vec_subtract(query.min, contact.translation);
+      query.max = vec_subtract(query.max, contact.translation);
     }
-    list_add(result, normal);
+    chain_query(contact.chain, query, visitor, &contact);
+  }
+  if (contact.found) {
+    result.collided = true;
+    // The normal points out of the chain, towards the other body
+    result.axis = chain_first ? contact.normal : vec_negate(contact.normal);
+    result.depth = contact.depth;
+    result.num_contacts = 1;
+    result.contacts[0] = contact.point;
   }
   return result;
 }
 
-double min(double a, double b) { return a < b ? a : b; }
+// Finds how far a circle sinks into a convex polygon, from the feature of the
+// polygon closest to the circle's center. The axis points from the polygon
+// towards the circle, and the point is the closest one on the polygon's edge.
+bool find_circle_overlap(vector_t center, double radius,
+                         const polygon_t *polygon, double *depth,
+                         vector_t *axis, vector_t *point) {
+  size_t size = polygon_size(polygon);
+  const double *xs = polygon_get_xs(polygon);
+  const double *ys = polygon_get_ys(polygon);
+  // The center is inside if it is on the same side of every edge
+  bool inside = true;
+  double side = 0.0;
+  double closest_squared = INFINITY;
+  vector_t closest = VEC_ZERO;
+  vector_t closest_edge = VEC_ZERO;
+  for (size_t i = 0; i < size; i++) {
+    size_t next = i + 1 < size ? i + 1 : 0;
+    vector_t start = {xs[i], ys[i]};
+    vector_t edge = vec_subtract((vector_t){xs[next], ys[next]}, start);
+    vector_t offset = vec_subtract(center, start);
+    double cross = vec_cross(edge, offset);
+    if (side == 0.0) {
+      side = cross;
+    } else if (cross * side < 0) {
+      inside = false;
+    }
+    double t = vec_dot(offset, edge) / vec_dot(edge, edge);
+    t = fmin(fmax(t, 0.0), 1.0);
+    vector_t nearest = vec_add(start, vec_multiply(t, edge));
+    vector_t gap = vec_subtract(center, nearest);
+    double distance_squared = vec_dot(gap, gap);
+    if (distance_squared < closest_squared) {
+      closest_squared = distance_squared;
+      closest = nearest;
+      closest_edge = edge;
+    }
+  }
+  if (!inside && closest_squared > radius * radius) {
+    return false;
+  }
+  double distance = sqrt(closest_squared);
+  *point = closest;
+  if (inside) {
+    // Out through the nearest edge, whose left normal points inwards if the
+    // polygon is counterclockwise
+    vector_t normal = vec_normal(closest_edge);
+    normal = vec_multiply((side > 0 ? -1 : 1) / vec_magn(normal), normal);
+    *axis = normal;
+    *depth = radius + distance;
+  } else {
+    *axis = vec_multiply(1 / distance, vec_subtract(center, closest));
+    *depth = radius - distance;
+  }
+  return true;
+}
 
-collision_info_t find_collision(list_t *shape1, list_t *shape2) {
-  list_t *edges1 = polygon_edges(shape1);
-  list_t *edges2 = polygon_edges(shape2);
-  list_t *normals = get_normals(edges1, edges2);
-  collision_info_t result;
-
-  list_free(edges1);
-  list_free(edges2);
-  double max1, min1;
-  double max2, min2;
-  double min_difference = INFINITY;
-  for (size_t i = 0; i < list_size(normals); i++) {
-    vector_t *normal = list_get(normals, i);
-    max1 = min1 = vec_scalar_project(*(vector_t *)list_get(shape1, 0), *normal);
-    for (size_t j = 1; j < list_size(shape1); j++) {
-      double proj =
-          vec_scalar_project(*(vector_t *)list_get(shape1, j), *normal);
-      if (proj > max1) {
-        max1 = proj;
+// Collides a circle body with another body, in O(1) for two circles and
+// otherwise in O(n) in the vertices of the other body's nearby parts
+collision_info_t find_circle_collision(body_t *body1, body_t *body2) {
+  collision_info_t result = {.collided = false, .axis = VEC_ZERO};
+  bool circle_first = body_is_circle(body1);
+  body_t *circle = circle_first ? body1 : body2;
+  body_t *other = circle_first ? body2 : body1;
+  vector_t center = body_get_centroid(circle);
+  double radius = body_get_radius(circle);
+  if (body_is_circle(other)) {
+    // Both are circles, so circle is body1
+    vector_t offset = vec_subtract(body_get_centroid(other), center);
+    double radii = radius + body_get_radius(other);
+    double distance = vec_magn(offset);
+    if (distance > radii) {
+      return result;
+    }
+    result.collided = true;
+    // Concentric circles can be pushed apart either way
+    result.axis = distance > 0 ? vec_multiply(1 / distance, offset)
+                               : (vector_t){0, 1};
+    result.depth = radii - distance;
+    result.num_contacts = 1;
+    // Halfway through the overlap
+    result.contacts[0] = vec_add(
+        center, vec_multiply(radius - result.depth / 2, result.axis));
+    return result;
+  }
+  aabb_t bounds = body_get_bounds(circle);
+  size_t first, end;
+  body_find_parts(other, bounds, &first, &end);
+  for (size_t i = first; i < end; i++) {
+    const polygon_t *part = body_get_part(other, i);
+    if (!aabb_overlaps(polygon_get_bounds(part), bounds)) {
+      continue;
+    }
+    double depth;
+    vector_t axis, point;
+    if (find_circle_overlap(center, radius, part, &depth, &axis, &point) &&
+        (!result.collided || depth > result.depth)) {
+      result.collided = true;
+      // axis points from other towards the circle
+      result.axis = circle_first ? vec_negate(axis) : axis;
+      result.depth = depth;
+      result.num_contacts = 1;
+      result.contacts[0] = point;
+    }
+  }
+  return result;
+}
+
+// find_body_collision(), but if *separating_axis is not VEC_ZERO, each pair
+// of parts is first tested against it. Afterwards *separating_axis is an
+// axis that separated the last pair of parts that needed a full test, or
+// VEC_ZERO if the bodies collided.
+collision_info_t find_body_collision_cached(body_t *body1, body_t *body2,
+                                            vector_t *separating_axis) {
+  collision_info_t result = {.collided = false, .axis = VEC_ZERO};
+  if (!aabb_overlaps(body_get_bounds(body1), body_get_bounds(body2))) {
+    return result;
+  }
+  vector_t offset = vec_subtract(body_get_bounding_center(body2),
+                                 body_get_bounding_center(body1));
+  double radii =
+      body_get_bounding_radius(body1) + body_get_bounding_radius(body2);
+  if (vec_dot(offset, offset) > radii * radii) {
+    return result;
+  }
+  if (body_get_chain(body1) != NULL || body_get_chain(body2) != NULL) {
+    return find_chain_collision(body1, body2);
+  }
+  if (body_is_circle(body1) || body_is_circle(body2)) {
+    return find_circle_collision(body1, body2);
+  }
+  vector_t hint = separating_axis != NULL ? *separating_axis : VEC_ZERO;
+  bool has_hint = hint.x != 0.0 || hint.y != 0.0;
+  // whether the hint separated every pair of parts it was tried on
+  bool hint_held = true;
+  bool hint_tried = false;
+  // Concave bodies collide if any of their convex parts do. The deepest
+  // pair of parts gives the axis and contact points.
+  overlap_t deepest = {.depth = -INFINITY};
+  size_t deepest1 = 0;
+  size_t deepest2 = 0;
+  size_t first1, end1, first2, end2;
+  body_find_parts(body1, body_get_bounds(body2), &first1, &end1);
+  body_find_parts(body2, body_get_bounds(body1), &first2, &end2);
+  for (size_t i = first1; i < end1; i++) {
+    const polygon_t *part1 = body_get_part(body1, i);
+    const polygon_t *normals1 = body_get_part_normals(body1, i);
+    const size_t *extremes1 = body_get_part_extremes(body1, i);
+    for (size_t j = first2; j < end2; j++) {
+      const polygon_t *part2 = body_get_part(body2, j);
+      if (!aabb_overlaps(polygon_get_bounds(part1),
+                         polygon_get_bounds(part2))) {
+        continue;
+      }
+      if (has_hint) {
+        hint_tried = true;
+        if (axis_separates(hint, part1, part2)) {
+          continue;
+        }
+        hint_held = false;
       }
-      if (proj < min1) {
-        min1 = proj;
+      overlap_t overlap;
+      if (find_convex_overlap(part1, normals1, extremes1, part2,
+                              body_get_part_normals(body2, j),
+                              body_get_part_extremes(body2, j), &overlap)) {
+        if (overlap.depth > deepest.depth) {
+          deepest = overlap;
+          deepest1 = i;
+          deepest2 = j;
+          result.collided = true;
+        }
+      } else if (separating_axis != NULL) {
+        *separating_axis = overlap.separating_axis;
       }
     }
-    max2 = min2 = vec_scalar_project(*(vector_t *)list_get(shape2, 0), *normal);
-    for (size_t j = 1; j < list_size(shape2); j++) {
-      double proj =
-          vec_scalar_project(*(vector_t *)list_get(shape2, j), *normal);
-      if (proj > max2) {
-        max2 = proj;
+  }
+  if (hint_tried) {
+    axis_cache_stats.lookups++;
+    axis_cache_stats.hits += hint_held;
+  }
+  if (result.collided) {
+    if (separating_axis != NULL) {
+      *separating_axis = VEC_ZERO;
+    }
+    result.axis = deepest.axis;
+    find_contact_points(body_get_part(body1, deepest1),
+                        body_get_part(body2, deepest2), deepest, &result);
+  }
+  return result;
+}
+
+collision_info_t find_body_collision(body_t *body1, body_t *body2) {
+  return find_body_collision_cached(body1, body2, NULL);
+}
+
+vector_t polygon_support_func(const void *shape, vector_t direction) {
+  return polygon_support(shape, direction);
+}
+
+vector_t point_support_func(const void *shape, vector_t direction) {
+  // Every direction has the same support point
+  (void)direction;
+  return *(const vector_t *)shape;
+}
+
+vector_t segment_support_func(const void *shape, vector_t direction) {
+  const segment_t *segment = shape;
+  return vec_dot(segment->start, direction) >= vec_dot(segment->end, direction)
+             ? segment->start
+             : segment->end;
+}
+
+support_shape_t support_polygon(const polygon_t *polygon, double radius) {
+  assert(radius >= 0);
+  return (support_shape_t){
+      .support = polygon_support_func, .shape = polygon, .radius = radius};
+}
+
+support_shape_t support_point(const vector_t *point, double radius) {
+  assert(radius >= 0);
+  return (support_shape_t){
+      .support = point_support_func, .shape = point, .radius = radius};
+}
+
+support_shape_t support_segment(const segment_t *segment, double radius) {
+  assert(radius >= 0);
+  return (support_shape_t){
+      .support = segment_support_func, .shape = segment, .radius = radius};
+}
+
+// A point of the Minkowski difference of two cores, core1 - core2, with the
+// point of each core it is the difference of
+typedef struct support_vertex {
+  vector_t point;
+  vector_t point1;
+  vector_t point2;
+} support_vertex_t;
+
+// The point of the cores' difference furthest along direction
+support_vertex_t find_support_vertex(support_shape_t shape1,
+                                     support_shape_t shape2,
+                                     vector_t direction) {
+  vector_t point1 = shape1.support(shape1.shape, direction);
+  vector_t point2 = shape2.support(shape2.shape, vec_negate(direction));
+  return (support_vertex_t){.point = vec_subtract(point1, point2),
+                            .point1 = point1,
+                            .point2 = point2};
+}
+
+// The parameter of the point of segment start to end closest to the origin
+double closest_on_segment(vector_t start, vector_t end) {
+  vector_t along = vec_subtract(end, start);
+  double length_squared = vec_dot(along, along);
+  if (length_squared == 0.0) {
+    return 0.0;
+  }
+  return fmin(fmax(-vec_dot(start, along) / length_squared, 0.0), 1.0);
+}
+
+// Reduces a segment simplex to the vertices needed for its point closest to
+// the origin, setting their weights in that point
+void gjk_reduce_segment(support_vertex_t *simplex, double *weights,
+                        size_t *size) {
+  double t = closest_on_segment(simplex[0].point, simplex[1].point);
+  if (t == 0.0) {
+    *size = 1;
+  } else if (t == 1.0) {
+    simplex[0] = simplex[1];
+    *size = 1;
+  } else {
+    *size = 2;
+  }
+  weights[0] = *size == 1 ? 1.0 : 1.0 - t;
+  weights[1] = t;
+}
+
+// Reduces a GJK simplex of up to 3 vertices as gjk_reduce_segment() does.
+// Returns false if the simplex is a triangle holding the origin.
+bool gjk_reduce(support_vertex_t *simplex, double *weights, size_t *size) {
+  if (*size == 1) {
+    weights[0] = 1.0;
+    return true;
+  }
+  if (*size == 2) {
+    gjk_reduce_segment(simplex, weights, size);
+    return true;
+  }
+  // The origin is inside if it is on the same side of every edge
+  double area = vec_cross(vec_subtract(simplex[1].point, simplex[0].point),
+                          vec_subtract(simplex[2].point, simplex[0].point));
+  bool inside = area != 0.0;
+  // Otherwise the closest point is on the closest edge
+  double closest_squared = INFINITY;
+  size_t closest = 0;
+  for (size_t i = 0; i < 3; i++) {
+    vector_t start = simplex[i].point;
+    vector_t end = simplex[(i + 1) % 3].point;
+    if (vec_cross(vec_subtract(end, start), vec_negate(start)) * area < 0) {
+      inside = false;
+    }
+    double t = closest_on_segment(start, end);
+    vector_t point = vec_add(start, vec_multiply(t, vec_subtract(end, start)));
+    if (vec_dot(point, point) < closest_squared) {
+      closest_squared = vec_dot(point, point);
+      closest = i;
+    }
+  }
+  if (inside) {
+    return false;
+  }
+  support_vertex_t edge[] = {simplex[closest], simplex[(closest + 1) % 3]};
+  simplex[0] = edge[0];
+  simplex[1] = edge[1];
+  *size = 2;
+  gjk_reduce_segment(simplex, weights, size);
+  return true;
+}
+
+// Adds vertices to a simplex holding the origin until it is a triangle with
+// some area. Returns false if the cores' difference has no area.
+bool gjk_fill_simplex(support_shape_t shape1, support_shape_t shape2,
+                      support_vertex_t *simplex, size_t *size) {
+  vector_t directions[] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+  for (size_t i = 0; i < 4 && *size < 2; i++) {
+    support_vertex_t vertex =
+        find_support_vertex(shape1, shape2, directions[i]);
+    vector_t gap = vec_subtract(vertex.point, simplex[0].point);
+    if (vec_dot(gap, gap) > GJK_EPSILON) {
+      simplex[(*size)++] = vertex;
+    }
+  }
+  if (*size < 2) {
+    return false;
+  }
+  vector_t normal =
+      vec_normal(vec_subtract(simplex[1].point, simplex[0].point));
+  for (size_t i = 0; i < 2 && *size < 3; i++) {
+    support_vertex_t vertex = find_support_vertex(
+        shape1, shape2, i == 0 ? normal : vec_negate(normal));
+    double area =
+        vec_cross(vec_subtract(simplex[1].point, simplex[0].point),
+                  vec_subtract(vertex.point, simplex[0].point));
+    if (fabs(area) > GJK_EPSILON) {
+      simplex[(*size)++] = vertex;
+    }
+  }
+  return *size == 3;
+}
+
+// Runs EPA on a triangle of the cores' difference that holds the origin,
+// storing the unit normal of the difference's edge closest to the origin,
+// its distance from the origin, and the points of the cores at its closest
+// point
+void epa(support_shape_t shape1, support_shape_t shape2,
+         const support_vertex_t *triangle, vector_t *normal, double *depth,
+         vector_t *point1, vector_t *point2) {
+  support_vertex_t polygon[EPA_MAX_VERTICES];
+  size_t size = 3;
+  polygon[0] = triangle[0];
+  // Counterclockwise, so each edge's right normal points outwards
+  bool clockwise =
+      vec_cross(vec_subtract(triangle[1].point, triangle[0].point),
+                vec_subtract(triangle[2].point, triangle[0].point)) < 0;
+  polygon[1] = triangle[clockwise ? 2 : 1];
+  polygon[2] = triangle[clockwise ? 1 : 2];
+  size_t closest = 0;
+  double distance = INFINITY;
+  vector_t outward = VEC_ZERO;
+  for (size_t iteration = 0; iteration < GJK_MAX_ITERATIONS; iteration++) {
+    distance = INFINITY;
+    for (size_t i = 0; i < size; i++) {
+      vector_t edge =
+          vec_subtract(polygon[(i + 1) % size].point, polygon[i].point);
+      vector_t edge_normal = {edge.y, -edge.x};
+      double length = vec_magn(edge_normal);
+      if (length == 0.0) {
+        continue;
       }
-      if (proj < min2) {
-        min2 = proj;
+      edge_normal = vec_multiply(1 / length, edge_normal);
+      double edge_distance = vec_dot(edge_normal, polygon[i].point);
+      if (edge_distance < distance) {
+        distance = edge_distance;
+        closest = i;
+        outward = edge_normal;
       }
     }
-    if ((min1 > max2) || (max1 < min2)) {
-      list_free(normals);
-      result.collided = false;
-      result.axis = VEC_ZERO;
-      return result;
+    if (size == EPA_MAX_VERTICES) {
+      break;
     }
-    double curr_difference = min(fabs(min1 - max2), fabs(min2 - max1));
-    if (min_difference > curr_difference) {
-      min_difference = curr_difference;
-      result.axis = *normal;
+    support_vertex_t vertex = find_support_vertex(shape1, shape2, outward);
+    if (vec_dot(vertex.point, outward) - distance <=
+        GJK_TOLERANCE * fmax(distance, 1.0)) {
+      break;
     }
+    for (size_t i = size; i > closest + 1; i--) {
+      polygon[i] = polygon[i - 1];
+    }
+    polygon[closest + 1] = vertex;
+    size++;
+  }
+  support_vertex_t start = polygon[closest];
+  support_vertex_t end = polygon[(closest + 1) % size];
+  double t = closest_on_segment(start.point, end.point);
+  *normal = outward;
+  *depth = distance;
+  *point1 = vec_add(start.point1,
+                    vec_multiply(t, vec_subtract(end.point1, start.point1)));
+  *point2 = vec_add(start.point2,
+                    vec_multiply(t, vec_subtract(end.point2, start.point2)));
+}
+
+distance_info_t find_convex_distance(support_shape_t shape1,
+                                     support_shape_t shape2) {
+  support_vertex_t simplex[3];
+  double weights[3];
+  size_t size = 1;
+  simplex[0] = find_support_vertex(shape1, shape2, (vector_t){1, 0});
+  weights[0] = 1.0;
+  // The point of the simplex closest to the origin
+  vector_t closest = simplex[0].point;
+  bool overlap = false;
+  for (size_t iteration = 0; iteration < GJK_MAX_ITERATIONS; iteration++) {
+    double closest_squared = vec_dot(closest, closest);
+    if (closest_squared <= GJK_EPSILON) {
+      overlap = true;
+      break;
+    }
+    support_vertex_t vertex =
+        find_support_vertex(shape1, shape2, vec_negate(closest));
+    // No point of the difference is much closer than the simplex's
+    if (closest_squared - vec_dot(closest, vertex.point) <=
+        GJK_TOLERANCE * closest_squared) {
+      break;
+    }
+    simplex[size++] = vertex;
+    if (!gjk_reduce(simplex, weights, &size)) {
+      overlap = true;
+      break;
+    }
+    closest = VEC_ZERO;
+    for (size_t i = 0; i < size; i++) {
+      closest = vec_add(closest, vec_multiply(weights[i], simplex[i].point));
+    }
+  }
+  distance_info_t result;
+  double core_distance;
+  vector_t core1 = VEC_ZERO;
+  vector_t core2 = VEC_ZERO;
+  if (overlap) {
+    if (gjk_fill_simplex(shape1, shape2, simplex, &size)) {
+      double depth;
+      epa(shape1, shape2, simplex, &result.axis, &depth, &core1, &core2);
+      core_distance = -depth;
+    } else {
+      // The cores are collinear segments, which overlap by nothing
+      core_distance = 0.0;
+      result.axis = vec_normal(
+          size > 1 ? vec_subtract(simplex[1].point, simplex[0].point)
+                   : (vector_t){1, 0});
+      result.axis = vec_multiply(1 / vec_magn(result.axis), result.axis);
+      core1 = simplex[0].point1;
+      core2 = simplex[0].point2;
+    }
+  } else {
+    core_distance = vec_magn(closest);
+    // closest is core1 - core2, so the axis from shape1 to shape2 opposes it
+    result.axis = vec_multiply(-1 / core_distance, closest);
+    for (size_t i = 0; i < size; i++) {
+      core1 = vec_add(core1, vec_multiply(weights[i], simplex[i].point1));
+      core2 = vec_add(core2, vec_multiply(weights[i], simplex[i].point2));
+    }
+  }
+  result.distance = core_distance - shape1.radius - shape2.radius;
+  result.collided = result.distance <= 0;
+  result.point1 = vec_add(core1, vec_multiply(shape1.radius, result.axis));
+  result.point2 = vec_subtract(core2, vec_multiply(shape2.radius, result.axis));
+  return result;
+}
+
+// A box grown by margin on every side
+aabb_t aabb_grow(aabb_t box, double margin) {
+  return (aabb_t){.min = {box.min.x - margin, box.min.y - margin},
+                  .max = {box.max.x + margin, box.max.y + margin}};
+}
+
+// One part of a body as a support shape. A circle body's one part is its
+// circle, whose center is stored in *center.
+support_shape_t body_part_support(body_t *body, size_t index,
+                                  vector_t *center) {
+  if (body_is_circle(body)) {
+    *center = body_get_centroid(body);
+    return support_point(center, body_get_radius(body));
+  }
+  return support_polygon(body_get_part(body, index), 0.0);
+}
+
+distance_info_t find_body_distance(body_t *body1, body_t *body2,
+                                   double max_distance) {
+  assert(body_get_chain(body1) == NULL && body_get_chain(body2) == NULL);
+  distance_info_t result = {
+      .collided = false, .distance = INFINITY, .axis = VEC_ZERO};
+  aabb_t reach1 = aabb_grow(body_get_bounds(body1), max_distance);
+  aabb_t reach2 = aabb_grow(body_get_bounds(body2), max_distance);
+  if (!aabb_overlaps(reach1, body_get_bounds(body2))) {
+    return result;
+  }
+  size_t first1, end1, first2, end2;
+  body_find_parts(body1, reach2, &first1, &end1);
+  body_find_parts(body2, reach1, &first2, &end2);
+  for (size_t i = first1; i < end1; i++) {
+    aabb_t part_reach =
+        aabb_grow(polygon_get_bounds(body_get_part(body1, i)), max_distance);
+    vector_t center1;
+    support_shape_t shape1 = body_part_support(body1, i, &center1);
+    for (size_t j = first2; j < end2; j++) {
+      if (!aabb_overlaps(part_reach,
+                         polygon_get_bounds(body_get_part(body2, j)))) {
+        continue;
+      }
+      vector_t center2;
+      support_shape_t shape2 = body_part_support(body2, j, &center2);
+      distance_info_t distance = find_convex_distance(shape1, shape2);
+      if (distance.distance < result.distance) {
+        result = distance;
+      }
+    }
+  }
+  if (result.distance > max_distance) {
+    result = (distance_info_t){
+        .collided = false, .distance = INFINITY, .axis = VEC_ZERO};
   }
-  list_free(normals);
-  result.collided = true;
   return result;
 }
+
+axis_cache_stats_t collision_get_axis_cache_stats(void) {
+  return axis_cache_stats;
+}
+
+void collision_reset_axis_cache_stats(void) {
+  axis_cache_stats = (axis_cache_stats_t){.lookups = 0, .hits = 0};
+}
+
+contact_t *contact_init(body_t *body1, body_t *body2) {
+  contact_t *contact = malloc(sizeof(*contact));
+  assert(contact != NULL);
+  *contact = (contact_t){.body1 = body1,
+                         .body2 = body2,
+                         .references = 1,
+                         .pooled = false,
+                         .valid = false,
+                         .separating_axis = VEC_ZERO};
+  return contact;
+}
+
+contact_t *contact_init_in(pool_t *pool, body_t *body1, body_t *body2) {
+  assert(pool_record_size(pool) >= sizeof(contact_t));
+  contact_t *contact = pool_alloc(pool);
+  *contact = (contact_t){.body1 = body1,
+                         .body2 = body2,
+                         .references = 1,
+                         .pooled = true,
+                         .valid = false,
+                         .separating_axis = VEC_ZERO};
+  return contact;
+}
+
+size_t contact_record_size(void) { return sizeof(contact_t); }
+
+contact_t *contact_retain(contact_t *contact) {
+  contact->references++;
+  return contact;
+}
+
+void contact_free(contact_t *contact) {
+  assert(contact->references > 0);
+  if (--contact->references == 0) {
+    if (contact->pooled) {
+      pool_release(contact);
+    } else {
+      free(contact);
+    }
+  }
+}
+
+body_t *contact_get_body1(contact_t *contact) { return contact->body1; }
+
+body_t *contact_get_body2(contact_t *contact) { return contact->body2; }
+
+collision_info_t contact_get_collision(contact_t *contact) {
+  size_t version1 = body_get_shape_version(contact->body1);
+  size_t version2 = body_get_shape_version(contact->body2);
+  if (!contact->valid || contact->version1 != version1 ||
+      contact->version2 != version2) {
+    contact->info = find_body_collision_cached(
+        contact->body1, contact->body2, &contact->separating_axis);
+    contact->version1 = version1;
+    contact->version2 = version2;
+    contact->valid = true;
+  }
+  return contact->info;
+}
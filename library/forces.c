@@ -3,6 +3,7 @@
 #include "collision.h"
 #include "list.h"
 #include "polygon.h"
+#include "pool.h"
 #include "scene.h"
 #include "vector.h"
 #include <assert.h>
@@ -20,7 +21,12 @@ typedef struct applied_force_arg {
   list_t *bodies;
 } applied_force_arg_t;
 
+typedef struct normal_arg {
+  contact_t *contact;
+} normal_arg_t;
+
 typedef struct collision_arg {
+  contact_t *contact;
   body_t *body1;
   body_t *body2;
   collision_handler_t handler;
@@ -29,6 +35,17 @@ typedef struct collision_arg {
   bool has_collided;
 } collision_arg_t;
 
+size_t force_arg_record_size(void) {
+  size_t sizes[] = {sizeof(force_arg_t), sizeof(applied_force_arg_t),
+                    sizeof(normal_arg_t), sizeof(collision_arg_t),
+                    sizeof(double)};
+  size_t max_size = 0;
+  for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+    max_size = sizes[i] > max_size ? sizes[i] : max_size;
+  }
+  return max_size;
+}
+
 bool is_close(double a, double b, double threshold) {
   return fabs(a - b) < threshold;
 }
@@ -37,7 +54,7 @@ void collision_arg_free(collision_arg_t *collision_arg) {
   if (collision_arg->freer != NULL) {
     collision_arg->freer(collision_arg->aux);
   }
-  free(collision_arg);
+  pool_release(collision_arg);
 }
 
 void applied_force_creator(void *aux) {
@@ -74,29 +91,15 @@ void downwards_gravity_creator(void *aux) {
 }
 
 void normal_creator(void *aux) {
-  list_t *bodies = ((force_arg_t *)aux)->bodies;
-  body_t *body = list_get(bodies, 0);
-  body_t *surface = list_get(bodies, 1);
-  list_t *body_shape = body_get_shape(body);
-  list_t *surface_shape = body_get_shape(surface);
-  collision_info_t collision = find_collision(body_shape, surface_shape);
+  contact_t *contact = ((normal_arg_t *)aux)->contact;
+  body_t *body = contact_get_body1(contact);
+  collision_info_t collision = contact_get_collision(contact);
   if (collision.collided) {
     double angle_diff =
         2 * M_PI - (body_get_rotation(body) - vec_angle(collision.axis));
     if (is_close(fmod(2 * fabs(angle_diff) / M_PI, 2), 0.0, 0.1)) {
       body_set_angular_velocity(body, 0.0);
     }
-    list_t *edges = polygon_edges(body_shape);
-    for (size_t i = 0; i < list_size(edges); i++) {
-      vector_t *edge = list_get(edges, i);
-      if (is_close(vec_dot(*edge, collision.axis), 0, 1e-5)) {
-        vector_t surface_vector = vec_rotate(collision.axis, M_PI / 2);
-        if (surface_vector.x < 0) {
-          surface_vector = vec_negate(surface_vector);
-        }
-        break;
-      }
-    }
     vector_t displacement = collision.axis;
     if (displacement.y < 0) {
       displacement = vec_negate(displacement);
@@ -109,10 +112,7 @@ void normal_creator(void *aux) {
                                                      displacement) /
                                   vec_magn(displacement)),
                              displacement)));
-    list_free(edges);
   }
-  list_free(body_shape);
-  list_free(surface_shape);
 }
 
 void spring_creator(void *aux) {
@@ -170,9 +170,7 @@ void physics_collision_handler(body_t *body1, body_t *body2, vector_t axis,
 
 void collision_creator(void *aux) {
   collision_arg_t *collision_arg = aux;
-  list_t *shape1 = body_get_shape(collision_arg->body1);
-  list_t *shape2 = body_get_shape(collision_arg->body2);
-  collision_info_t collision = find_collision(shape1, shape2);
+  collision_info_t collision = contact_get_collision(collision_arg->contact);
   if (collision.collided && !collision_arg->has_collided) {
     collision_arg->handler(collision_arg->body1, collision_arg->body2,
                            collision.axis, collision_arg->aux);
@@ -180,17 +178,16 @@ void collision_creator(void *aux) {
   } else if (!collision.collided) {
     collision_arg->has_collided = false;
   }
-  list_free(shape1);
-  list_free(shape2);
 }
 
-void create_applied(scene_t *scene, vector_t force, body_t *body) {
+force_t *create_applied(scene_t *scene, vector_t force, body_t *body) {
   list_t *bodies = list_init(1, NULL);
   list_add(bodies, body);
-  applied_force_arg_t *force_args = malloc(sizeof(applied_force_arg_t));
+  applied_force_arg_t *force_args =
+      scene_alloc_record(scene, sizeof(applied_force_arg_t));
   *force_args = (applied_force_arg_t){.force = force, .bodies = bodies};
-  scene_add_bodies_force_creator(scene, applied_force_creator, force_args,
-                                 bodies, free);
+  return scene_add_bodies_force_creator(scene, applied_force_creator,
+                                        force_args, bodies, pool_release);
 }
 
 void create_newtonian_gravity(scene_t *scene, double G, body_t *body1,
@@ -198,65 +195,68 @@ void create_newtonian_gravity(scene_t *scene, double G, body_t *body1,
   list_t *bodies = list_init(2, NULL);
   list_add(bodies, body1);
   list_add(bodies, body2);
-  force_arg_t *gravity_args = malloc(sizeof(force_arg_t));
+  force_arg_t *gravity_args = scene_alloc_record(scene, sizeof(force_arg_t));
   *gravity_args = (force_arg_t){.constant = G, .bodies = bodies};
   scene_add_bodies_force_creator(scene, newtonian_gravity_creator, gravity_args,
-                                 bodies, (free_func_t)free);
+                                 bodies, pool_release);
 }
 
 void create_downwards_gravity(scene_t *scene, double g, body_t *body) {
   list_t *bodies = list_init(1, NULL);
   list_add(bodies, body);
-  force_arg_t *gravity_args = malloc(sizeof(force_arg_t));
+  force_arg_t *gravity_args = scene_alloc_record(scene, sizeof(force_arg_t));
   *gravity_args = (force_arg_t){.constant = g, .bodies = bodies};
   scene_add_bodies_force_creator(scene, downwards_gravity_creator, gravity_args,
-                                 bodies, free);
+                                 bodies, pool_release);
 }
 
 void create_normal(scene_t *scene, body_t *body, body_t *surface) {
   list_t *bodies = list_init(2, NULL);
   list_add(bodies, body);
   list_add(bodies, surface);
-  force_arg_t *normal_args = malloc(sizeof(force_arg_t));
-  *normal_args = (force_arg_t){.constant = 0.0, .bodies = bodies};
-  scene_add_bodies_force_creator(scene, normal_creator, normal_args, bodies,
-                                 free);
+  normal_arg_t *normal_args = scene_alloc_record(scene, sizeof(normal_arg_t));
+  normal_args->contact = force_get_contact(scene_add_contact_force_creator(
+      scene, normal_creator, normal_args, bodies, pool_release));
 }
 
 void create_spring(scene_t *scene, double k, body_t *body1, body_t *body2) {
   list_t *bodies = list_init(2, NULL);
   list_add(bodies, body1);
   list_add(bodies, body2);
-  force_arg_t *spring_args = malloc(sizeof(force_arg_t));
+  force_arg_t *spring_args = scene_alloc_record(scene, sizeof(force_arg_t));
   *spring_args = (force_arg_t){.constant = k, .bodies = bodies};
   scene_add_bodies_force_creator(scene, spring_creator, spring_args, bodies,
-                                 (free_func_t)free);
+                                 pool_release);
 }
 
-void create_drag(scene_t *scene, double gamma, body_t *body) {
+force_t *create_drag(scene_t *scene, double gamma, body_t *body) {
   list_t *bodies = list_init(1, NULL);
   list_add(bodies, body);
-  force_arg_t *drag_args = malloc(sizeof(force_arg_t));
+  force_arg_t *drag_args = scene_alloc_record(scene, sizeof(force_arg_t));
   *drag_args = (force_arg_t){.constant = gamma, .bodies = bodies};
-  scene_add_bodies_force_creator(scene, drag_creator, drag_args, bodies,
-                                 (free_func_t)free);
+  return scene_add_bodies_force_creator(scene, drag_creator, drag_args, bodies,
+                                        pool_release);
 }
 
-void create_collision(scene_t *scene, body_t *body1, body_t *body2,
-                      collision_handler_t handler, void *aux,
-                      free_func_t freer) {
+force_t *create_collision(scene_t *scene, body_t *body1, body_t *body2,
+                          collision_handler_t handler, void *aux,
+                          free_func_t freer) {
   list_t *bodies = list_init(2, NULL);
   list_add(bodies, body1);
   list_add(bodies, body2);
-  collision_arg_t *collision_arg = malloc(sizeof(collision_arg_t));
+  collision_arg_t *collision_arg =
+      scene_alloc_record(scene, sizeof(collision_arg_t));
   collision_arg->body1 = body1;
   collision_arg->body2 = body2;
   collision_arg->handler = handler;
   collision_arg->aux = aux;
   collision_arg->freer = freer;
-  scene_add_bodies_force_creator(scene, (force_creator_t)collision_creator,
-                                 collision_arg, bodies,
-                                 (free_func_t)collision_arg_free);
+  collision_arg->has_collided = false;
+  force_t *force = scene_add_contact_force_creator(
+      scene, (force_creator_t)collision_creator, collision_arg, bodies,
+      (free_func_t)collision_arg_free);
+  collision_arg->contact = force_get_contact(force);
+  return force;
 }
 
 void create_destructive_collision(scene_t *scene, body_t *body1,
@@ -267,8 +267,9 @@ void create_destructive_collision(scene_t *scene, body_t *body1,
 
 void create_physics_collision(scene_t *scene, double elasticity, body_t *body1,
                               body_t *body2) {
-  double *aux = malloc(sizeof(double));
+  double *aux = scene_alloc_record(scene, sizeof(double));
   *aux = elasticity;
   create_collision(scene, body1, body2,
-                   (collision_handler_t)physics_collision_handler, aux, free);
+                   (collision_handler_t)physics_collision_handler, aux,
+                   pool_release);
 };
@@ -0,0 +1,145 @@
+#include "heightfield.h"
+#include "list.h"
+#include "polygon.h"
+#include "vector.h"
+#include <assert.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+typedef struct heightfield {
+  // sample i is (xs[i], heights[i]); xs strictly increases
+  double *xs;
+  double *heights;
+  size_t size;
+  double base;
+  double max_height;
+} heightfield_t;
+
+heightfield_t *heightfield_init(list_t *samples, double base) {
+  size_t size = list_size(samples);
+  assert(size >= 2);
+  heightfield_t *heightfield = malloc(sizeof(heightfield_t));
+  assert(heightfield != NULL);
+  heightfield->xs = malloc(sizeof(double) * 2 * size);
+  assert(heightfield->xs != NULL);
+  heightfield->heights = heightfield->xs + size;
+  heightfield->size = size;
+  heightfield->base = base;
+  heightfield->max_height = base;
+  for (size_t i = 0; i < size; i++) {
+    vector_t *sample = list_get(samples, i);
+    assert(i == 0 || sample->x > heightfield->xs[i - 1]);
+    assert(sample->y >= base);
+    heightfield->xs[i] = sample->x;
+    heightfield->heights[i] = sample->y;
+    heightfield->max_height = fmax(heightfield->max_height, sample->y);
+  }
+  list_free(samples);
+  return heightfield;
+}
+
+void heightfield_free(heightfield_t *heightfield) {
+  free(heightfield->xs);
+  free(heightfield);
+}
+
+size_t heightfield_num_columns(const heightfield_t *heightfield) {
+  return heightfield->size - 1;
+}
+
+aabb_t heightfield_get_bounds(const heightfield_t *heightfield) {
+  return (aabb_t){
+      .min = {heightfield->xs[0], heightfield->base},
+      .max = {heightfield->xs[heightfield->size - 1], heightfield->max_height}};
+}
+
+// The number of samples left of x, or at x too if inclusive, by binary search
+size_t heightfield_count_samples(const heightfield_t *heightfield, double x,
+                                 bool inclusive) {
+  size_t low = 0;
+  size_t high = heightfield->size;
+  while (low < high) {
+    size_t middle = low + (high - low) / 2;
+    double sample_x = heightfield->xs[middle];
+    if (sample_x < x || (inclusive && sample_x == x)) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+void heightfield_find_columns(const heightfield_t *heightfield, double min_x,
+                              double max_x, size_t *first, size_t *end) {
+  size_t num_columns = heightfield_num_columns(heightfield);
+  if (max_x < heightfield->xs[0] || min_x > heightfield->xs[num_columns]) {
+    *first = 0;
+    *end = 0;
+    return;
+  }
+  // Column i spans xs[i] to xs[i + 1], so it is in the range unless it ends
+  // before min_x or starts after max_x. Columns that only touch the range
+  // are included, as touching shapes count as colliding.
+  size_t left = heightfield_count_samples(heightfield, min_x, false);
+  *first = left > 0 ? left - 1 : 0;
+  size_t right = heightfield_count_samples(heightfield, max_x, true);
+  *end = right < num_columns ? right : num_columns;
+}
+
+double heightfield_get_height(const heightfield_t *heightfield, double x) {
+  size_t last = heightfield->size - 1;
+  if (x < heightfield->xs[0] || x > heightfield->xs[last]) {
+    return NAN;
+  }
+  size_t right = heightfield_count_samples(heightfield, x, false);
+  if (right == 0) {
+    return heightfield->heights[0];
+  }
+  size_t left = right - 1;
+  double t = (x - heightfield->xs[left]) /
+             (heightfield->xs[right] - heightfield->xs[left]);
+  return heightfield->heights[left] +
+         t * (heightfield->heights[right] - heightfield->heights[left]);
+}
+
+polygon_t *heightfield_get_column(const heightfield_t *heightfield,
+                                  size_t index) {
+  return heightfield_get_column_in(NULL, heightfield, index);
+}
+
+polygon_t *heightfield_get_column_in(arena_t *arena,
+                                     const heightfield_t *heightfield,
+                                     size_t index) {
+  assert(index < heightfield_num_columns(heightfield));
+  double left = heightfield->xs[index];
+  double right = heightfield->xs[index + 1];
+  polygon_t *column = polygon_init_in(arena, 4);
+  polygon_add_vertex(column, (vector_t){left, heightfield->base});
+  polygon_add_vertex(column, (vector_t){left, heightfield->heights[index]});
+  polygon_add_vertex(column,
+                     (vector_t){right, heightfield->heights[index + 1]});
+  polygon_add_vertex(column, (vector_t){right, heightfield->base});
+  return column;
+}
+
+polygon_t *heightfield_get_outline(const heightfield_t *heightfield) {
+  return heightfield_get_outline_in(NULL, heightfield);
+}
+
+polygon_t *heightfield_get_outline_in(arena_t *arena,
+                                      const heightfield_t *heightfield) {
+  size_t last = heightfield->size - 1;
+  polygon_t *outline = polygon_init_in(arena, heightfield->size + 2);
+  polygon_add_vertex(outline,
+                     (vector_t){heightfield->xs[0], heightfield->base});
+  polygon_add_vertex(outline,
+                     (vector_t){heightfield->xs[last], heightfield->base});
+  for (size_t i = heightfield->size; i > 0; i--) {
+    polygon_add_vertex(outline,
+                       (vector_t){heightfield->xs[i - 1],
+                                  heightfield->heights[i - 1]});
+  }
+  return outline;
+}
@@ -47,6 +47,14 @@ void *list_get(list_t *list, size_t index) {
   return list->data[index];
 }
 
+void *list_set(list_t *list, size_t index, void *value) {
+  assert(index < list->size);
+  assert(value != NULL);
+  void *old_element = list->data[index];
+  list->data[index] = value;
+  return old_element;
+}
+
 void list_add(list_t *list, void *value) {
   assert(value != NULL);
   if (list->capacity == list->size) {
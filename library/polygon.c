@@ -1,8 +1,104 @@
+#include "polygon.h"
+#include "arena.h"
 #include "list.h"
 #include "vec_list.h"
 #include "vector.h"
 #include <assert.h>
+#include <math.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+const size_t POLYGON_SCALING_FACTOR = 2;
+// unit normals whose cross product is at most this are treated as parallel
+const double POLYGON_PARALLEL_TOLERANCE = 1e-12;
+// turns whose sine is at least -POLYGON_CONVEX_TOLERANCE count as convex
+const double POLYGON_CONVEX_TOLERANCE = 1e-9;
+// marks an edge of the remaining polygon that is not a diagonal
+const size_t POLYGON_NO_DIAGONAL = SIZE_MAX;
+// convex polygons with fewer vertices are projected by scanning them, which
+// beats climbing to their extreme vertices
+const size_t POLYGON_CLIMB_SIZE = 16;
+// polygons are only climbed if each turn's cross product exceeds this times
+// the lengths of its edges and the size of the coordinates, far above the
+// rounding in a dot product, so every local maximum is the global one
+const double POLYGON_CLIMB_TOLERANCE = 1e-12;
+
+typedef struct polygon {
+  size_t size;
+  size_t capacity;
+  // xs and ys share one allocation: xs = data, ys = data + capacity
+  double *data;
+  double *xs;
+  double *ys;
+  // bounding box cache, recomputed lazily after the vertices change
+  aabb_t bounds;
+  bool bounds_valid;
+  // strict convexity cache, also recomputed lazily after the vertices change
+  bool strictly_convex;
+  bool convexity_valid;
+  // the vertex polygon_support() last returned, where its next climb starts
+  size_t support_hint;
+  // if non-NULL, the polygon and its vertices live in this arena
+  arena_t *arena;
+} polygon_t;
+
+// Rotates (x - pivot) by the angle whose cosine and sine are given, then adds
+// pivot + translation. Every path does the same operations in the same order,
+// so with FP contraction off (see the Makefile) the vector and scalar loops
+// produce bit-identical results.
+void polygon_transform_arrays(double *out_xs, double *out_ys, const double *xs,
+                              const double *ys, size_t size, double cos_angle,
+                              double sin_angle, vector_t pivot,
+                              vector_t translation) {
+  vector_t offset = vec_add(pivot, translation);
+  size_t i = 0;
+#if defined(__AVX__)
+  __m256d cos4 = _mm256_set1_pd(cos_angle);
+  __m256d sin4 = _mm256_set1_pd(sin_angle);
+  __m256d pivot_x4 = _mm256_set1_pd(pivot.x);
+  __m256d pivot_y4 = _mm256_set1_pd(pivot.y);
+  __m256d offset_x4 = _mm256_set1_pd(offset.x);
+  __m256d offset_y4 = _mm256_set1_pd(offset.y);
+  for (; i + 4 <= size; i += 4) {
+    __m256d x = _mm256_sub_pd(_mm256_loadu_pd(xs + i), pivot_x4);
+    __m256d y = _mm256_sub_pd(_mm256_loadu_pd(ys + i), pivot_y4);
+    __m256d new_x =
+        _mm256_sub_pd(_mm256_mul_pd(x, cos4), _mm256_mul_pd(y, sin4));
+    __m256d new_y =
+        _mm256_add_pd(_mm256_mul_pd(x, sin4), _mm256_mul_pd(y, cos4));
+    _mm256_storeu_pd(out_xs + i, _mm256_add_pd(new_x, offset_x4));
+    _mm256_storeu_pd(out_ys + i, _mm256_add_pd(new_y, offset_y4));
+  }
+#endif
+#if defined(__SSE2__)
+  __m128d cos2 = _mm_set1_pd(cos_angle);
+  __m128d sin2 = _mm_set1_pd(sin_angle);
+  __m128d pivot_x2 = _mm_set1_pd(pivot.x);
+  __m128d pivot_y2 = _mm_set1_pd(pivot.y);
+  __m128d offset_x2 = _mm_set1_pd(offset.x);
+  __m128d offset_y2 = _mm_set1_pd(offset.y);
+  for (; i + 2 <= size; i += 2) {
+    __m128d x = _mm_sub_pd(_mm_loadu_pd(xs + i), pivot_x2);
+    __m128d y = _mm_sub_pd(_mm_loadu_pd(ys + i), pivot_y2);
+    __m128d new_x = _mm_sub_pd(_mm_mul_pd(x, cos2), _mm_mul_pd(y, sin2));
+    __m128d new_y = _mm_add_pd(_mm_mul_pd(x, sin2), _mm_mul_pd(y, cos2));
+    _mm_storeu_pd(out_xs + i, _mm_add_pd(new_x, offset_x2));
+    _mm_storeu_pd(out_ys + i, _mm_add_pd(new_y, offset_y2));
+  }
+#endif
+  for (; i < size; i++) {
+    double x = xs[i] - pivot.x;
+    double y = ys[i] - pivot.y;
+    out_xs[i] = x * cos_angle - y * sin_angle + offset.x;
+    out_ys[i] = x * sin_angle + y * cos_angle + offset.y;
+  }
+}
 
 double polygon_area(list_t *polygon) {
   const int AREA_SCALING_FACTOR = 2;
@@ -57,14 +153,13 @@ void polygon_translate(list_t *polygon, vector_t translation) {
 
 void polygon_rotate(list_t *polygon, double angle, vector_t point) {
   size_t size = list_size(polygon);
-  // shift rotation to coincide with origin
-  polygon_translate(polygon, vec_negate(point));
+  double cos_angle = cos(angle);
+  double sin_angle = sin(angle);
   for (size_t i = 0; i < size; i++) {
     vector_t *v_ptr = list_get(polygon, i);
-    *v_ptr = vec_rotate(*v_ptr, angle);
+    polygon_transform_arrays(&v_ptr->x, &v_ptr->y, &v_ptr->x, &v_ptr->y, 1,
+                             cos_angle, sin_angle, point, VEC_ZERO);
   }
-  // shift reference point back
-  polygon_translate(polygon, point);
 }
 
 list_t *polygon_edges(list_t *polygon) {
@@ -77,4 +172,808 @@ list_t *polygon_edges(list_t *polygon) {
     list_add(result, edge_vector);
   }
   return result;
-}
\ No newline at end of file
+}
+
+void polygon_reserve(polygon_t *polygon, size_t capacity) {
+  size_t data_size = 2 * capacity * sizeof(double);
+  double *data = polygon->arena != NULL ? arena_alloc(polygon->arena, data_size)
+                                        : malloc(data_size);
+  assert(data != NULL);
+  if (polygon->data != NULL) {
+    memcpy(data, polygon->xs, polygon->size * sizeof(double));
+    memcpy(data + capacity, polygon->ys, polygon->size * sizeof(double));
+    if (polygon->arena == NULL) {
+      free(polygon->data);
+    }
+  }
+  polygon->data = data;
+  polygon->xs = data;
+  polygon->ys = data + capacity;
+  polygon->capacity = capacity;
+}
+
+polygon_t *polygon_init(size_t initial_size) {
+  return polygon_init_in(NULL, initial_size);
+}
+
+polygon_t *polygon_init_in(arena_t *arena, size_t initial_size) {
+  polygon_t *result = arena != NULL ? arena_alloc(arena, sizeof(polygon_t))
+                                    : malloc(sizeof(polygon_t));
+  assert(result != NULL);
+  *result = (polygon_t){
+      .size = 0, .data = NULL, .bounds_valid = false,
+      .convexity_valid = false, .support_hint = 0, .arena = arena};
+  polygon_reserve(result, initial_size > 0 ? initial_size : 1);
+  return result;
+}
+
+polygon_t *polygon_from_list(list_t *vertices) {
+  return polygon_from_list_in(NULL, vertices);
+}
+
+polygon_t *polygon_from_list_in(arena_t *arena, list_t *vertices) {
+  size_t size = list_size(vertices);
+  polygon_t *result = polygon_init_in(arena, size);
+  for (size_t i = 0; i < size; i++) {
+    vector_t *vertex = list_get(vertices, i);
+    result->xs[i] = vertex->x;
+    result->ys[i] = vertex->y;
+  }
+  result->size = size;
+  return result;
+}
+
+list_t *polygon_to_list(const polygon_t *polygon) {
+  list_t *result = list_init(polygon->size, free);
+  for (size_t i = 0; i < polygon->size; i++) {
+    vector_t *vertex = malloc(sizeof(vector_t));
+    assert(vertex != NULL);
+    *vertex = (vector_t){polygon->xs[i], polygon->ys[i]};
+    list_add(result, vertex);
+  }
+  return result;
+}
+
+polygon_t *polygon_copy(const polygon_t *polygon) {
+  return polygon_copy_in(NULL, polygon);
+}
+
+polygon_t *polygon_copy_in(arena_t *arena, const polygon_t *polygon) {
+  polygon_t *result = polygon_init_in(arena, polygon->size);
+  memcpy(result->xs, polygon->xs, polygon->size * sizeof(double));
+  memcpy(result->ys, polygon->ys, polygon->size * sizeof(double));
+  result->size = polygon->size;
+  result->bounds = polygon->bounds;
+  result->bounds_valid = polygon->bounds_valid;
+  result->strictly_convex = polygon->strictly_convex;
+  result->convexity_valid = polygon->convexity_valid;
+  return result;
+}
+
+void polygon_free(polygon_t *polygon) {
+  // Arena polygons are released all at once by arena_reset()
+  if (polygon->arena != NULL) {
+    return;
+  }
+  free(polygon->data);
+  free(polygon);
+}
+
+size_t polygon_size(const polygon_t *polygon) { return polygon->size; }
+
+vector_t polygon_get_vertex(const polygon_t *polygon, size_t index) {
+  assert(index < polygon->size);
+  return (vector_t){polygon->xs[index], polygon->ys[index]};
+}
+
+void polygon_set_vertex(polygon_t *polygon, size_t index, vector_t vertex) {
+  assert(index < polygon->size);
+  polygon->xs[index] = vertex.x;
+  polygon->ys[index] = vertex.y;
+  polygon->bounds_valid = false;
+  polygon->convexity_valid = false;
+}
+
+void polygon_add_vertex(polygon_t *polygon, vector_t vertex) {
+  if (polygon->size == polygon->capacity) {
+    polygon_reserve(polygon, polygon->capacity * POLYGON_SCALING_FACTOR);
+  }
+  polygon->xs[polygon->size] = vertex.x;
+  polygon->ys[polygon->size] = vertex.y;
+  polygon->size++;
+  polygon->bounds_valid = false;
+  polygon->convexity_valid = false;
+}
+
+const double *polygon_get_xs(const polygon_t *polygon) { return polygon->xs; }
+
+const double *polygon_get_ys(const polygon_t *polygon) { return polygon->ys; }
+
+double polygon_get_area(const polygon_t *polygon) {
+  const int AREA_SCALING_FACTOR = 2;
+  double area = 0;
+  size_t size = polygon->size;
+  // shoelace theorem
+  for (size_t i = 0; i < size; i++) {
+    size_t next = i == size - 1 ? 0 : i + 1;
+    area += polygon->xs[i] * polygon->ys[next] -
+            polygon->ys[i] * polygon->xs[next];
+  }
+  area /= AREA_SCALING_FACTOR;
+  return area;
+}
+
+vector_t polygon_get_centroid(const polygon_t *polygon) {
+  const int CENTROID_SCALING_FACTOR = 6;
+  double x = 0;
+  double y = 0;
+  size_t size = polygon->size;
+  for (size_t i = 0; i < size; i++) {
+    size_t next = i == size - 1 ? 0 : i + 1;
+    double cross = polygon->xs[i] * polygon->ys[next] -
+                   polygon->ys[i] * polygon->xs[next];
+    x += (polygon->xs[i] + polygon->xs[next]) * cross;
+    y += (polygon->ys[i] + polygon->ys[next]) * cross;
+  }
+  double area = polygon_get_area(polygon);
+  vector_t centroid = {.x = x / (CENTROID_SCALING_FACTOR * area),
+                       .y = y / (CENTROID_SCALING_FACTOR * area)};
+  return centroid;
+}
+
+void polygon_translate_vertices(polygon_t *polygon, vector_t translation) {
+  for (size_t i = 0; i < polygon->size; i++) {
+    polygon->xs[i] += translation.x;
+    polygon->ys[i] += translation.y;
+  }
+  polygon->bounds_valid = false;
+  polygon->convexity_valid = false;
+}
+
+void polygon_rotate_vertices(polygon_t *polygon, double angle,
+                             vector_t point) {
+  polygon_transform_arrays(polygon->xs, polygon->ys, polygon->xs, polygon->ys,
+                           polygon->size, cos(angle), sin(angle), point,
+                           VEC_ZERO);
+  polygon->bounds_valid = false;
+  polygon->convexity_valid = false;
+}
+
+void polygon_transform(polygon_t *result, const polygon_t *polygon,
+                       double angle, vector_t translation) {
+  if (result->capacity < polygon->size) {
+    polygon_reserve(result, polygon->size);
+  }
+  polygon_transform_arrays(result->xs, result->ys, polygon->xs, polygon->ys,
+                           polygon->size, cos(angle), sin(angle), VEC_ZERO,
+                           translation);
+  result->size = polygon->size;
+  result->bounds_valid = false;
+  result->convexity_valid = false;
+}
+
+void polygon_project(const polygon_t *polygon, vector_t axis, double *min,
+                     double *max) {
+  assert(polygon->size > 0);
+  const double *xs = polygon->xs;
+  const double *ys = polygon->ys;
+  size_t size = polygon->size;
+  double lo = xs[0] * axis.x + ys[0] * axis.y;
+  double hi = lo;
+  size_t i = 1;
+  // Projections are computed exactly as in the scalar loop below, and min and
+  // max don't round, so with FP contraction off (see the Makefile) every path
+  // yields the same bounds.
+#if defined(__AVX__)
+  if (size >= 5) {
+    __m256d axis_x4 = _mm256_set1_pd(axis.x);
+    __m256d axis_y4 = _mm256_set1_pd(axis.y);
+    __m256d lo4 = _mm256_set1_pd(lo);
+    __m256d hi4 = lo4;
+    for (; i + 4 <= size; i += 4) {
+      __m256d proj =
+          _mm256_add_pd(_mm256_mul_pd(_mm256_loadu_pd(xs + i), axis_x4),
+                        _mm256_mul_pd(_mm256_loadu_pd(ys + i), axis_y4));
+      lo4 = _mm256_min_pd(lo4, proj);
+      hi4 = _mm256_max_pd(hi4, proj);
+    }
+    __m128d lo2 = _mm_min_pd(_mm256_castpd256_pd128(lo4),
+                             _mm256_extractf128_pd(lo4, 1));
+    __m128d hi2 = _mm_max_pd(_mm256_castpd256_pd128(hi4),
+                             _mm256_extractf128_pd(hi4, 1));
+    lo = _mm_cvtsd_f64(_mm_min_sd(lo2, _mm_unpackhi_pd(lo2, lo2)));
+    hi = _mm_cvtsd_f64(_mm_max_sd(hi2, _mm_unpackhi_pd(hi2, hi2)));
+  }
+#elif defined(__SSE2__)
+  if (size >= 3) {
+    __m128d axis_x2 = _mm_set1_pd(axis.x);
+    __m128d axis_y2 = _mm_set1_pd(axis.y);
+    __m128d lo2 = _mm_set1_pd(lo);
+    __m128d hi2 = lo2;
+    for (; i + 2 <= size; i += 2) {
+      __m128d proj = _mm_add_pd(_mm_mul_pd(_mm_loadu_pd(xs + i), axis_x2),
+                                _mm_mul_pd(_mm_loadu_pd(ys + i), axis_y2));
+      lo2 = _mm_min_pd(lo2, proj);
+      hi2 = _mm_max_pd(hi2, proj);
+    }
+    lo = _mm_cvtsd_f64(_mm_min_sd(lo2, _mm_unpackhi_pd(lo2, lo2)));
+    hi = _mm_cvtsd_f64(_mm_max_sd(hi2, _mm_unpackhi_pd(hi2, hi2)));
+  }
+#endif
+  for (; i < size; i++) {
+    double proj = xs[i] * axis.x + ys[i] * axis.y;
+    if (proj < lo) {
+      lo = proj;
+    }
+    if (proj > hi) {
+      hi = proj;
+    }
+  }
+  *min = lo;
+  *max = hi;
+}
+
+bool polygon_is_strictly_convex(const polygon_t *polygon) {
+  if (polygon->convexity_valid) {
+    return polygon->strictly_convex;
+  }
+  size_t size = polygon->size;
+  const double *xs = polygon->xs;
+  const double *ys = polygon->ys;
+  double scale = 0;
+  for (size_t i = 0; i < size; i++) {
+    scale = fmax(scale, fabs(xs[i]) + fabs(ys[i]));
+  }
+  // Every turn must go the same way, by a margin that rounding can't erase.
+  // Straight runs, repeated vertices and dents all fail this.
+  bool convex = size >= 3;
+  double turn_sign = 0;
+  for (size_t i = 0; convex && i < size; i++) {
+    size_t prev = (i + size - 1) % size;
+    size_t next = (i + 1) % size;
+    double prev_x = xs[i] - xs[prev];
+    double prev_y = ys[i] - ys[prev];
+    double next_x = xs[next] - xs[i];
+    double next_y = ys[next] - ys[i];
+    double cross = prev_x * next_y - prev_y * next_x;
+    double margin = POLYGON_CLIMB_TOLERANCE * scale *
+                    (fabs(prev_x) + fabs(prev_y) + fabs(next_x) +
+                     fabs(next_y));
+    if (turn_sign == 0) {
+      turn_sign = cross > 0 ? 1 : -1;
+    }
+    convex = turn_sign * cross > margin;
+  }
+  // Only the cache changes, so this is still logically a const operation
+  polygon_t *cache = (polygon_t *)polygon;
+  cache->strictly_convex = convex;
+  cache->convexity_valid = true;
+  return convex;
+}
+
+size_t polygon_extreme_vertex(const polygon_t *polygon, vector_t direction,
+                              size_t start) {
+  size_t size = polygon->size;
+  assert(size > 0);
+  const double *xs = polygon->xs;
+  const double *ys = polygon->ys;
+  if (!polygon_is_strictly_convex(polygon)) {
+    size_t best = 0;
+    double best_dot = xs[0] * direction.x + ys[0] * direction.y;
+    for (size_t i = 1; i < size; i++) {
+      double dot = xs[i] * direction.x + ys[i] * direction.y;
+      if (dot > best_dot) {
+        best = i;
+        best_dot = dot;
+      }
+    }
+    return best;
+  }
+  size_t best = start % size;
+  double best_dot = xs[best] * direction.x + ys[best] * direction.y;
+  size_t max_step = size / 2;
+  size_t step = 1;
+  // Projections rise from the nearest vertex to the furthest and fall back
+  // around the other side, and on a strictly convex polygon rounding can't
+  // make a vertex look higher than both neighbours anywhere else. The step
+  // doubles while it keeps climbing and halves once it overshoots.
+  while (true) {
+    size_t forward = (best + step) % size;
+    size_t backward = (best + size - step) % size;
+    double forward_dot = xs[forward] * direction.x + ys[forward] * direction.y;
+    double backward_dot =
+        xs[backward] * direction.x + ys[backward] * direction.y;
+    if (forward_dot > best_dot || backward_dot > best_dot) {
+      bool forwards = forward_dot >= backward_dot;
+      best = forwards ? forward : backward;
+      best_dot = forwards ? forward_dot : backward_dot;
+      step = 2 * step <= max_step ? 2 * step : max_step;
+    } else if (step > 1) {
+      step /= 2;
+    } else {
+      break;
+    }
+  }
+  return best;
+}
+
+void polygon_project_convex(const polygon_t *polygon, vector_t axis,
+                            size_t *min_vertex, size_t *max_vertex,
+                            double *min, double *max) {
+  if (polygon->size < POLYGON_CLIMB_SIZE ||
+      !polygon_is_strictly_convex(polygon)) {
+    polygon_project(polygon, axis, min, max);
+    return;
+  }
+  *min_vertex = polygon_extreme_vertex(polygon, vec_negate(axis), *min_vertex);
+  *max_vertex = polygon_extreme_vertex(polygon, axis, *max_vertex);
+  // The same dot products polygon_project() takes
+  *min = polygon->xs[*min_vertex] * axis.x + polygon->ys[*min_vertex] * axis.y;
+  *max = polygon->xs[*max_vertex] * axis.x + polygon->ys[*max_vertex] * axis.y;
+}
+
+size_t *polygon_get_extremes(const polygon_t *polygon, const polygon_t *axes) {
+  return polygon_get_extremes_in(NULL, polygon, axes);
+}
+
+size_t *polygon_get_extremes_in(arena_t *arena, const polygon_t *polygon,
+                                const polygon_t *axes) {
+  assert(polygon->size > 0);
+  size_t extremes_size = sizeof(size_t) * 2 * axes->size;
+  size_t *extremes = arena != NULL ? arena_alloc(arena, extremes_size)
+                                   : malloc(extremes_size);
+  assert(extremes != NULL);
+  for (size_t i = 0; i < axes->size; i++) {
+    vector_t axis = {axes->xs[i], axes->ys[i]};
+    size_t lowest = 0;
+    size_t highest = 0;
+    double low = polygon->xs[0] * axis.x + polygon->ys[0] * axis.y;
+    double high = low;
+    for (size_t j = 1; j < polygon->size; j++) {
+      double dot = polygon->xs[j] * axis.x + polygon->ys[j] * axis.y;
+      if (dot < low) {
+        lowest = j;
+        low = dot;
+      }
+      if (dot > high) {
+        highest = j;
+        high = dot;
+      }
+    }
+    extremes[2 * i] = lowest;
+    extremes[2 * i + 1] = highest;
+  }
+  return extremes;
+}
+
+vector_t polygon_support(const polygon_t *polygon, vector_t direction) {
+  assert(polygon->size > 0);
+  size_t best = 0;
+  if (polygon->size >= POLYGON_CLIMB_SIZE) {
+    // GJK's directions settle as it converges, so the last answer is
+    // usually at or next to this one. Only the hint changes, so this is
+    // still logically a const operation.
+    best = polygon_extreme_vertex(polygon, direction, polygon->support_hint);
+    ((polygon_t *)polygon)->support_hint = best;
+  } else {
+    double best_dot =
+        polygon->xs[0] * direction.x + polygon->ys[0] * direction.y;
+    for (size_t i = 1; i < polygon->size; i++) {
+      double dot = polygon->xs[i] * direction.x + polygon->ys[i] * direction.y;
+      if (dot > best_dot) {
+        best = i;
+        best_dot = dot;
+      }
+    }
+  }
+  return (vector_t){polygon->xs[best], polygon->ys[best]};
+}
+
+aabb_t polygon_get_bounds(const polygon_t *polygon) {
+  assert(polygon->size > 0);
+  if (polygon->bounds_valid) {
+    return polygon->bounds;
+  }
+  aabb_t bounds = {.min = {polygon->xs[0], polygon->ys[0]},
+                   .max = {polygon->xs[0], polygon->ys[0]}};
+  for (size_t i = 1; i < polygon->size; i++) {
+    bounds.min.x = fmin(bounds.min.x, polygon->xs[i]);
+    bounds.max.x = fmax(bounds.max.x, polygon->xs[i]);
+    bounds.min.y = fmin(bounds.min.y, polygon->ys[i]);
+    bounds.max.y = fmax(bounds.max.y, polygon->ys[i]);
+  }
+  // Only the cache changes, so this is still logically a const operation
+  polygon_t *cache = (polygon_t *)polygon;
+  cache->bounds = bounds;
+  cache->bounds_valid = true;
+  return bounds;
+}
+
+bool aabb_overlaps(aabb_t box1, aabb_t box2) {
+  return box1.min.x <= box2.max.x && box2.min.x <= box1.max.x &&
+         box1.min.y <= box2.max.y && box2.min.y <= box1.max.y;
+}
+
+polygon_t *polygon_get_normals(const polygon_t *polygon) {
+  return polygon_get_normals_in(NULL, polygon);
+}
+
+polygon_t *polygon_get_normals_in(arena_t *arena, const polygon_t *polygon) {
+  polygon_t *result = polygon_init_in(arena, polygon->size);
+  for (size_t i = 0; i < polygon->size; i++) {
+    size_t next = i + 1 < polygon->size ? i + 1 : 0;
+    vector_t edge = {polygon->xs[next] - polygon->xs[i],
+                     polygon->ys[next] - polygon->ys[i]};
+    vector_t normal = vec_normal(edge);
+    double magnitude = vec_magn(normal);
+    if (magnitude == 0.0) {
+      continue;
+    }
+    normal = vec_multiply(1 / magnitude, normal);
+    // Opposite or repeated normals give the same projections, so keep one
+    bool parallel = false;
+    for (size_t j = 0; j < result->size && !parallel; j++) {
+      vector_t other = {result->xs[j], result->ys[j]};
+      parallel = fabs(vec_cross(normal, other)) <= POLYGON_PARALLEL_TOLERANCE;
+    }
+    if (!parallel) {
+      polygon_add_vertex(result, normal);
+    }
+  }
+  return result;
+}
+
+// Whether the path a -> b -> c turns left, or continues straight within
+// POLYGON_CONVEX_TOLERANCE
+bool polygon_turns_left(vector_t a, vector_t b, vector_t c) {
+  vector_t edge1 = vec_subtract(b, a);
+  vector_t edge2 = vec_subtract(c, b);
+  return vec_cross(edge1, edge2) >=
+         -POLYGON_CONVEX_TOLERANCE * vec_magn(edge1) * vec_magn(edge2);
+}
+
+bool polygon_is_convex(const polygon_t *polygon) {
+  size_t size = polygon->size;
+  bool counterclockwise = polygon_get_area(polygon) >= 0;
+  for (size_t i = 0; i < size; i++) {
+    vector_t prev = polygon_get_vertex(polygon, (i + size - 1) % size);
+    vector_t curr = polygon_get_vertex(polygon, i);
+    vector_t next = polygon_get_vertex(polygon, (i + 1) % size);
+    bool left = counterclockwise ? polygon_turns_left(prev, curr, next)
+                                 : polygon_turns_left(next, curr, prev);
+    if (!left) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Working state of polygon_decompose(). Vertices are referred to by their
+// index in the original polygon; ccw lists them counterclockwise.
+typedef struct decomposition {
+  const polygon_t *polygon;
+  size_t *ccw;
+  // the remaining polygon, as a linked cycle of positions in ccw
+  size_t *prev;
+  size_t *next;
+  // the diagonal along the edge from each position to next, if any
+  size_t *edge_diagonal;
+  // triangles clipped so far, as 3 positions each
+  size_t *triangles;
+  size_t num_triangles;
+  // each diagonal's endpoints, the triangle that has the edge from its end to
+  // its start, and the triangle that has the edge from its start to its end
+  size_t *diagonal_start;
+  size_t *diagonal_end;
+  size_t *diagonal_ear;
+  size_t *diagonal_other;
+  size_t num_diagonals;
+} decomposition_t;
+
+vector_t decomposition_vertex(decomposition_t *d, size_t position) {
+  return polygon_get_vertex(d->polygon, d->ccw[position]);
+}
+
+// Whether point lies inside or on the counterclockwise triangle (a, b, c)
+bool triangle_contains(vector_t a, vector_t b, vector_t c, vector_t point) {
+  return vec_cross(vec_subtract(b, a), vec_subtract(point, a)) >= 0 &&
+         vec_cross(vec_subtract(c, b), vec_subtract(point, b)) >= 0 &&
+         vec_cross(vec_subtract(a, c), vec_subtract(point, c)) >= 0;
+}
+
+// Whether the remaining vertex at position is an ear: a strictly convex
+// corner whose triangle holds no other reflex vertex
+bool decomposition_is_ear(decomposition_t *d, size_t position) {
+  vector_t a = decomposition_vertex(d, d->prev[position]);
+  vector_t b = decomposition_vertex(d, position);
+  vector_t c = decomposition_vertex(d, d->next[position]);
+  if (vec_cross(vec_subtract(b, a), vec_subtract(c, b)) <= 0) {
+    return false;
+  }
+  for (size_t other = d->next[d->next[position]]; other != d->prev[position];
+       other = d->next[other]) {
+    vector_t before = decomposition_vertex(d, d->prev[other]);
+    vector_t v = decomposition_vertex(d, other);
+    vector_t after = decomposition_vertex(d, d->next[other]);
+    bool reflex =
+        vec_cross(vec_subtract(v, before), vec_subtract(after, v)) < 0;
+    bool shared = (v.x == a.x && v.y == a.y) || (v.x == b.x && v.y == b.y) ||
+                  (v.x == c.x && v.y == c.y);
+    if (reflex && !shared && triangle_contains(a, b, c, v)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Cuts off the triangle at position, recording the diagonal that closes it
+void decomposition_clip(decomposition_t *d, size_t position) {
+  size_t prev = d->prev[position];
+  size_t next = d->next[position];
+  size_t triangle = d->num_triangles++;
+  d->triangles[3 * triangle] = prev;
+  d->triangles[3 * triangle + 1] = position;
+  d->triangles[3 * triangle + 2] = next;
+  size_t consumed[] = {d->edge_diagonal[prev], d->edge_diagonal[position]};
+  for (size_t i = 0; i < 2; i++) {
+    if (consumed[i] != POLYGON_NO_DIAGONAL) {
+      d->diagonal_other[consumed[i]] = triangle;
+    }
+  }
+  size_t diagonal = d->num_diagonals++;
+  d->diagonal_start[diagonal] = prev;
+  d->diagonal_end[diagonal] = next;
+  d->diagonal_ear[diagonal] = triangle;
+  d->edge_diagonal[prev] = diagonal;
+  d->next[prev] = next;
+  d->prev[next] = prev;
+}
+
+// Triangulates the polygon by ear clipping. If no ear can be found, which
+// only happens when the outline crosses itself, the current corner is
+// clipped anyway so that the loop always finishes.
+void decomposition_triangulate(decomposition_t *d, size_t size) {
+  size_t position = 0;
+  size_t remaining = size;
+  size_t attempts = 0;
+  while (remaining > 3) {
+    if (decomposition_is_ear(d, position) || attempts >= remaining) {
+      size_t next = d->next[position];
+      decomposition_clip(d, position);
+      position = next;
+      remaining--;
+      attempts = 0;
+    } else {
+      position = d->next[position];
+      attempts++;
+    }
+  }
+  size_t triangle = d->num_triangles++;
+  for (size_t i = 0; i < 3; i++) {
+    d->triangles[3 * triangle + i] = position;
+    if (d->edge_diagonal[position] != POLYGON_NO_DIAGONAL) {
+      d->diagonal_other[d->edge_diagonal[position]] = triangle;
+    }
+    position = d->next[position];
+  }
+}
+
+size_t decomposition_find(size_t *parent, size_t part) {
+  while (parent[part] != part) {
+    parent[part] = parent[parent[part]];
+    part = parent[part];
+  }
+  return part;
+}
+
+size_t decomposition_index_of(const size_t *cycle, size_t size,
+                              size_t position) {
+  for (size_t i = 0; i < size; i++) {
+    if (cycle[i] == position) {
+      return i;
+    }
+  }
+  return size;
+}
+
+list_t *polygon_decompose(const polygon_t *polygon) {
+  list_t *parts = list_init(1, (free_func_t)polygon_free);
+  size_t size = polygon->size;
+  if (size < 4 || polygon_is_convex(polygon)) {
+    list_add(parts, polygon_copy(polygon));
+    return parts;
+  }
+  bool counterclockwise = polygon_get_area(polygon) >= 0;
+  size_t num_triangles = size - 2;
+  size_t *buffer = malloc(sizeof(size_t) * (8 * size + 3 * num_triangles));
+  assert(buffer != NULL);
+  decomposition_t d = {.polygon = polygon,
+                       .ccw = buffer,
+                       .prev = buffer + size,
+                       .next = buffer + 2 * size,
+                       .edge_diagonal = buffer + 3 * size,
+                       .triangles = buffer + 4 * size,
+                       .diagonal_start = buffer + 4 * size + 3 * num_triangles,
+                       .diagonal_end = buffer + 5 * size + 3 * num_triangles,
+                       .diagonal_ear = buffer + 6 * size + 3 * num_triangles,
+                       .diagonal_other = buffer + 7 * size + 3 * num_triangles,
+                       .num_triangles = 0,
+                       .num_diagonals = 0};
+  for (size_t i = 0; i < size; i++) {
+    d.ccw[i] = counterclockwise ? i : size - 1 - i;
+    d.prev[i] = (i + size - 1) % size;
+    d.next[i] = (i + 1) % size;
+    d.edge_diagonal[i] = POLYGON_NO_DIAGONAL;
+  }
+  decomposition_triangulate(&d, size);
+
+  // Hertel-Mehlhorn: remove each diagonal whose two sides stay convex when
+  // joined. Parts are cycles of positions, tracked with union-find.
+  size_t *parent = malloc(sizeof(size_t) * num_triangles);
+  size_t **cycles = malloc(sizeof(size_t *) * num_triangles);
+  size_t *cycle_sizes = malloc(sizeof(size_t) * num_triangles);
+  assert(parent != NULL && cycles != NULL && cycle_sizes != NULL);
+  for (size_t i = 0; i < num_triangles; i++) {
+    parent[i] = i;
+    cycles[i] = malloc(sizeof(size_t) * 3);
+    assert(cycles[i] != NULL);
+    memcpy(cycles[i], d.triangles + 3 * i, sizeof(size_t) * 3);
+    cycle_sizes[i] = 3;
+  }
+  for (size_t i = 0; i < d.num_diagonals; i++) {
+    size_t part1 = decomposition_find(parent, d.diagonal_other[i]);
+    size_t part2 = decomposition_find(parent, d.diagonal_ear[i]);
+    size_t start = d.diagonal_start[i];
+    size_t end = d.diagonal_end[i];
+    size_t *cycle1 = cycles[part1];
+    size_t *cycle2 = cycles[part2];
+    size_t size1 = cycle_sizes[part1];
+    size_t size2 = cycle_sizes[part2];
+    // cycle1 goes start -> end, and cycle2 goes end -> start
+    size_t index1 = decomposition_index_of(cycle1, size1, start);
+    size_t index2 = decomposition_index_of(cycle2, size2, end);
+    if (part1 == part2 || index1 == size1 || index2 == size2 ||
+        cycle1[(index1 + 1) % size1] != end ||
+        cycle2[(index2 + 1) % size2] != start) {
+      continue;
+    }
+    bool convex_at_start = polygon_turns_left(
+        decomposition_vertex(&d, cycle1[(index1 + size1 - 1) % size1]),
+        decomposition_vertex(&d, start),
+        decomposition_vertex(&d, cycle2[(index2 + 2) % size2]));
+    bool convex_at_end = polygon_turns_left(
+        decomposition_vertex(&d, cycle2[(index2 + size2 - 1) % size2]),
+        decomposition_vertex(&d, end),
+        decomposition_vertex(&d, cycle1[(index1 + 2) % size1]));
+    if (!convex_at_start || !convex_at_end) {
+      continue;
+    }
+    // end ... start along cycle1, then the rest of cycle2
+    size_t *merged = malloc(sizeof(size_t) * (size1 + size2 - 2));
+    assert(merged != NULL);
+    size_t merged_size = 0;
+    for (size_t j = 0; j < size1; j++) {
+      merged[merged_size++] = cycle1[(index1 + 1 + j) % size1];
+    }
+    for (size_t j = 2; j < size2; j++) {
+      merged[merged_size++] = cycle2[(index2 + j) % size2];
+    }
+    free(cycle1);
+    free(cycle2);
+    cycles[part2] = NULL;
+    cycles[part1] = merged;
+    cycle_sizes[part1] = merged_size;
+    parent[part2] = part1;
+  }
+
+  for (size_t i = 0; i < num_triangles; i++) {
+    if (parent[i] != i) {
+      continue;
+    }
+    polygon_t *part = polygon_init(cycle_sizes[i]);
+    for (size_t j = 0; j < cycle_sizes[i]; j++) {
+      polygon_add_vertex(part, decomposition_vertex(&d, cycles[i][j]));
+    }
+    free(cycles[i]);
+    // Slivers left by a self-crossing outline have nothing to collide with
+    if (polygon_get_area(part) <= 0) {
+      polygon_free(part);
+      continue;
+    }
+    list_add(parts, part);
+  }
+  free(cycle_sizes);
+  free(cycles);
+  free(parent);
+  free(buffer);
+  return parts;
+}
+
+// Distance from point to the segment from start to end
+double segment_distance(vector_t start, vector_t end, vector_t point) {
+  vector_t segment = vec_subtract(end, start);
+  vector_t offset = vec_subtract(point, start);
+  double length_squared = vec_dot(segment, segment);
+  double t = length_squared > 0 ? vec_dot(offset, segment) / length_squared : 0;
+  t = fmax(0, fmin(1, t));
+  return vec_magn(vec_subtract(offset, vec_multiply(t, segment)));
+}
+
+// Finds the vertex strictly between start and end (indices taken modulo the
+// polygon's size) farthest from the segment joining them. Returns end if
+// there are no vertices in between.
+size_t polygon_farthest_from_segment(const polygon_t *polygon, size_t start,
+                                     size_t end, double *distance) {
+  size_t size = polygon->size;
+  vector_t a = polygon_get_vertex(polygon, start % size);
+  vector_t b = polygon_get_vertex(polygon, end % size);
+  size_t farthest = end;
+  *distance = 0;
+  for (size_t i = start + 1; i < end; i++) {
+    double d = segment_distance(a, b, polygon_get_vertex(polygon, i % size));
+    if (d > *distance) {
+      *distance = d;
+      farthest = i;
+    }
+  }
+  return farthest;
+}
+
+// Douglas-Peucker on the chain of vertices from start to end
+void polygon_simplify_chain(const polygon_t *polygon, size_t start, size_t end,
+                            double tolerance, bool *keep) {
+  double distance;
+  size_t farthest =
+      polygon_farthest_from_segment(polygon, start, end, &distance);
+  if (farthest == end || distance <= tolerance) {
+    return;
+  }
+  keep[farthest % polygon->size] = true;
+  polygon_simplify_chain(polygon, start, farthest, tolerance, keep);
+  polygon_simplify_chain(polygon, farthest, end, tolerance, keep);
+}
+
+polygon_t *polygon_simplify(const polygon_t *polygon, double tolerance) {
+  size_t size = polygon->size;
+  if (size <= 3) {
+    return polygon_copy(polygon);
+  }
+  // Split the closed outline into two chains at vertex 0 and the vertex
+  // farthest from it, which are both kept
+  vector_t first = polygon_get_vertex(polygon, 0);
+  size_t split = 1;
+  for (size_t i = 2; i < size; i++) {
+    if (vec_magn(vec_subtract(polygon_get_vertex(polygon, i), first)) >
+        vec_magn(vec_subtract(polygon_get_vertex(polygon, split), first))) {
+      split = i;
+    }
+  }
+  bool *keep = calloc(size, sizeof(bool));
+  assert(keep != NULL);
+  keep[0] = true;
+  keep[split] = true;
+  polygon_simplify_chain(polygon, 0, split, tolerance, keep);
+  polygon_simplify_chain(polygon, split, size, tolerance, keep);
+  size_t kept = 0;
+  for (size_t i = 0; i < size; i++) {
+    kept += keep[i];
+  }
+  // Everything fit within the tolerance of a line; keep a third vertex so
+  // the result still has an area
+  if (kept < 3) {
+    double distance1, distance2;
+    size_t farthest1 =
+        polygon_farthest_from_segment(polygon, 0, split, &distance1);
+    size_t farthest2 =
+        polygon_farthest_from_segment(polygon, split, size, &distance2);
+    keep[(distance1 >= distance2 ? farthest1 : farthest2) % size] = true;
+  }
+  polygon_t *result = polygon_init(size);
+  for (size_t i = 0; i < size; i++) {
+    if (keep[i]) {
+      polygon_add_vertex(result, polygon_get_vertex(polygon, i));
+    }
+  }
+  free(keep);
+  return result;
+}
@@ -0,0 +1,84 @@
+#include "pool.h"
+#include "list.h"
+#include <assert.h>
+#include <stdalign.h>
+#include <stdlib.h>
+
+const size_t POOL_SCALING_FACTOR = 2;
+
+// Every record is preceded by a header naming its pool, so pool_release()
+// only needs the record. While a record is released, the header instead
+// links it into the pool's free list.
+typedef union record_header {
+  struct pool *pool;
+  union record_header *next_free;
+  max_align_t align;
+} record_header_t;
+
+typedef struct pool {
+  size_t record_size;
+  // the size of a header and record together, a multiple of the alignment
+  size_t stride;
+  list_t *slabs;
+  // the number of records in the most recent slab
+  size_t slab_records;
+  record_header_t *free_list;
+  size_t records;
+} pool_t;
+
+// Allocates a slab of the given number of records and frees all of them
+void pool_add_slab(pool_t *pool, size_t num_records) {
+  char *slab = malloc(num_records * pool->stride);
+  assert(slab != NULL);
+  list_add(pool->slabs, slab);
+  pool->slab_records = num_records;
+  for (size_t i = num_records; i > 0; i--) {
+    record_header_t *header =
+        (record_header_t *)(slab + (i - 1) * pool->stride);
+    header->next_free = pool->free_list;
+    pool->free_list = header;
+  }
+}
+
+pool_t *pool_init(size_t record_size, size_t initial_records) {
+  pool_t *result = malloc(sizeof(pool_t));
+  assert(result != NULL);
+  size_t alignment = sizeof(record_header_t);
+  result->record_size = record_size;
+  result->stride = sizeof(record_header_t) +
+                   (record_size + alignment - 1) / alignment * alignment;
+  result->slabs = list_init(1, free);
+  result->free_list = NULL;
+  result->records = 0;
+  pool_add_slab(result, initial_records > 0 ? initial_records : 1);
+  return result;
+}
+
+void pool_free(pool_t *pool) {
+  list_free(pool->slabs);
+  free(pool);
+}
+
+void *pool_alloc(pool_t *pool) {
+  if (pool->free_list == NULL) {
+    pool_add_slab(pool, pool->slab_records * POOL_SCALING_FACTOR);
+  }
+  record_header_t *header = pool->free_list;
+  pool->free_list = header->next_free;
+  header->pool = pool;
+  pool->records++;
+  return header + 1;
+}
+
+void pool_release(void *record) {
+  record_header_t *header = (record_header_t *)record - 1;
+  pool_t *pool = header->pool;
+  assert(pool->records > 0);
+  header->next_free = pool->free_list;
+  pool->free_list = header;
+  pool->records--;
+}
+
+size_t pool_record_size(pool_t *pool) { return pool->record_size; }
+
+size_t pool_records(pool_t *pool) { return pool->records; }
@@ -1,17 +1,58 @@
 #include "scene.h"
+#include "arena.h"
 #include "body.h"
+#include "collision.h"
 #include "forces.h"
 #include "list.h"
+#include "polygon.h"
+#include "pool.h"
 #include <assert.h>
+#include <math.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
 
 const size_t BASE_NUM_BODIES = 10;
+const size_t SCENE_SCRATCH_SIZE = 4096;
+// bytes to start the body arena with per body, enough for a small polygon
+const size_t SCENE_BODY_SIZE = 1024;
+// bisection steps used to refine a bullet's time of impact
+const size_t BULLET_BISECTIONS = 10;
+// force creators with at most this many bodies keep their slots inline
+#define INLINE_BODY_SLOTS 2
+
+// A body in the broadphase, with the contact forces that involve it
+typedef struct proxy {
+  body_t *body;
+  aabb_t bounds;
+  list_t *contacts;
+} proxy_t;
 
 typedef struct scene {
   list_t *bodies;
+  // the dynamic and kinematic bodies, which are the only ones ticked
+  list_t *moving_bodies;
   list_t *forces;
+  // bodies and forces unloaded from the scene and not loaded back yet,
+  // which the scene still owns
+  list_t *unloaded_bodies;
+  list_t *unloaded_forces;
+  // set when removed force creators are still waiting to be freed
+  bool forces_dirty;
+  // bodies with contact forces, sorted by bounds.min.x (sweep and prune)
+  proxy_t *proxies;
+  size_t num_proxies;
+  size_t proxy_capacity;
+  // set whenever contact forces are added or removed
+  bool proxies_dirty;
+  size_t ticks;
+  // temporary memory for the current tick, reset at the start of each tick
+  arena_t *scratch;
+  // bodies made with scene_get_body_arena(), released with the scene
+  arena_t *body_arena;
+  // force_t records, and small records such as contacts and force arguments
+  pool_t *force_pool;
+  pool_t *record_pool;
 } scene_t;
 
 typedef struct force {
@@ -19,13 +60,38 @@ typedef struct force {
   void *aux;
   list_t *bodies;
   free_func_t freer;
+  bool is_contact;
+  // the pair's cached collision, shared with other contact forces on it
+  contact_t *contact;
+  // the last tick on which the broadphase saw the bodies' bounds overlap
+  size_t overlap_tick;
+  // whether the force ran because of an overlap on the previous tick
+  bool was_overlapping;
+  // the index of the force in each of its bodies' body_get_forces() lists
+  size_t *body_slots;
+  size_t inline_slots[INLINE_BODY_SLOTS];
+  // removed forces stay in the scene's list until scene_compact_forces()
+  bool removed;
 } force_t;
 
-force_t *force_init(force_creator_t forcer, void *aux, list_t *bodies,
-                    free_func_t freer) {
-  force_t *force = malloc(sizeof(*force));
-  *force =
-      (force_t){.forcer = forcer, .aux = aux, .bodies = bodies, .freer = freer};
+force_t *force_init(pool_t *pool, force_creator_t forcer, void *aux,
+                    list_t *bodies, free_func_t freer) {
+  force_t *force = pool_alloc(pool);
+  *force = (force_t){.forcer = forcer,
+                     .aux = aux,
+                     .bodies = bodies,
+                     .freer = freer,
+                     .is_contact = false,
+                     .contact = NULL,
+                     .overlap_tick = 0,
+                     .was_overlapping = false,
+                     .body_slots = NULL,
+                     .removed = false};
+  size_t num_bodies = list_size(bodies);
+  force->body_slots = num_bodies <= INLINE_BODY_SLOTS
+                          ? force->inline_slots
+                          : malloc(num_bodies * sizeof(size_t));
+  assert(force->body_slots != NULL);
   return force;
 }
 
@@ -33,21 +99,104 @@ void force_free(force_t *force) {
   if (force->freer != NULL) {
     force->freer(force->aux);
   }
+  if (force->contact != NULL) {
+    contact_free(force->contact);
+  }
   list_free(force->bodies);
-  free(force);
+  if (force->body_slots != force->inline_slots) {
+    free(force->body_slots);
+  }
+  pool_release(force);
+}
+
+contact_t *force_get_contact(force_t *force) { return force->contact; }
+
+// Records the force in each of its bodies' lists of forces
+void force_link(force_t *force) {
+  for (size_t i = 0; i < list_size(force->bodies); i++) {
+    list_t *forces = body_get_forces(list_get(force->bodies, i));
+    force->body_slots[i] = list_size(forces);
+    list_add(forces, force);
+  }
+}
+
+// Removes the force from each of its bodies' lists of forces in O(1),
+// by moving the last force in the list into its slot
+void force_unlink(force_t *force) {
+  for (size_t i = 0; i < list_size(force->bodies); i++) {
+    body_t *body = list_get(force->bodies, i);
+    list_t *forces = body_get_forces(body);
+    size_t slot = force->body_slots[i];
+    force_t *last = list_remove(forces, list_size(forces) - 1);
+    size_t last_slot = list_size(forces);
+    if (slot == last_slot) {
+      continue;
+    }
+    list_set(forces, slot, last);
+    for (size_t j = 0; j < list_size(last->bodies); j++) {
+      if (list_get(last->bodies, j) == body &&
+          last->body_slots[j] == last_slot) {
+        last->body_slots[j] = slot;
+        break;
+      }
+    }
+  }
 }
 
 scene_t *scene_init() {
+  return scene_init_with_capacity(BASE_NUM_BODIES, BASE_NUM_BODIES);
+}
+
+scene_t *scene_init_with_capacity(size_t num_bodies, size_t num_forces) {
   scene_t *result = malloc(sizeof(scene_t));
   assert(result != NULL);
-  result->bodies = list_init(BASE_NUM_BODIES, (free_func_t)body_free);
-  result->forces = list_init(BASE_NUM_BODIES, (free_func_t)force_free);
+  num_bodies = num_bodies > 0 ? num_bodies : 1;
+  num_forces = num_forces > 0 ? num_forces : 1;
+  result->bodies = list_init(num_bodies, (free_func_t)body_free);
+  result->moving_bodies = list_init(num_bodies, NULL);
+  result->forces = list_init(num_forces, (free_func_t)force_free);
+  result->unloaded_bodies = list_init(1, (free_func_t)body_free);
+  result->unloaded_forces = list_init(1, (free_func_t)force_free);
+  result->forces_dirty = false;
+  result->proxies = malloc(num_bodies * sizeof(proxy_t));
+  assert(result->proxies != NULL);
+  result->num_proxies = 0;
+  result->proxy_capacity = num_bodies;
+  result->proxies_dirty = false;
+  result->ticks = 0;
+  result->scratch = arena_init(SCENE_SCRATCH_SIZE);
+  result->body_arena = arena_init(num_bodies * SCENE_BODY_SIZE);
+  result->force_pool = pool_init(sizeof(force_t), num_forces);
+  // Contact forces need a contact and their arguments; others need arguments
+  size_t contact_size = contact_record_size();
+  size_t arg_size = force_arg_record_size();
+  size_t record_size = contact_size > arg_size ? contact_size : arg_size;
+  result->record_pool = pool_init(record_size, 2 * num_forces);
   return result;
 }
 
+void scene_clear_proxies(scene_t *scene) {
+  for (size_t i = 0; i < scene->num_proxies; i++) {
+    list_free(scene->proxies[i].contacts);
+  }
+  scene->num_proxies = 0;
+}
+
 void scene_free(scene_t *scene) {
   list_free(scene->bodies);
+  list_free(scene->moving_bodies);
   list_free(scene->forces);
+  list_free(scene->unloaded_bodies);
+  list_free(scene->unloaded_forces);
+  scene_clear_proxies(scene);
+  free(scene->proxies);
+  arena_free(scene->scratch);
+  // After the bodies, since body_free() reads the bodies in the arena
+  arena_free(scene->body_arena);
+  // Releases every pooled record at once, including any that force creators
+  // or bodies still hold
+  pool_free(scene->force_pool);
+  pool_free(scene->record_pool);
   free(scene);
 }
 
@@ -60,6 +209,9 @@ body_t *scene_get_body(scene_t *scene, size_t index) {
 
 void scene_add_body(scene_t *scene, body_t *body) {
   list_add(scene->bodies, body);
+  if (body_get_motion_type(body) != MOTION_STATIC) {
+    list_add(scene->moving_bodies, body);
+  }
 }
 
 void scene_remove_body(scene_t *scene, size_t index) {
@@ -67,82 +219,391 @@ void scene_remove_body(scene_t *scene, size_t index) {
   body_remove(list_get(scene->bodies, index));
 }
 
-void scene_add_force_creator(scene_t *scene, force_creator_t forcer, void *aux,
-                             free_func_t freer) {
-  scene_add_bodies_force_creator(scene, forcer, aux, list_init(0, NULL), freer);
+// Decorations are render-only, so no force creator may act on them
+void scene_assert_not_decorations(list_t *bodies) {
+  for (size_t i = 0; i < list_size(bodies); i++) {
+    assert(!body_is_decoration(list_get(bodies, i)));
+  }
+}
+
+void scene_add_force(scene_t *scene, force_t *force) {
+  list_add(scene->forces, force);
+  force_link(force);
+}
+
+force_t *scene_add_force_creator(scene_t *scene, force_creator_t forcer,
+                                 void *aux, free_func_t freer) {
+  return scene_add_bodies_force_creator(scene, forcer, aux, list_init(0, NULL),
+                                        freer);
+}
+
+force_t *scene_add_bodies_force_creator(scene_t *scene, force_creator_t forcer,
+                                        void *aux, list_t *bodies,
+                                        free_func_t freer) {
+  scene_assert_not_decorations(bodies);
+  force_t *force = force_init(scene->force_pool, forcer, aux, bodies, freer);
+  scene_add_force(scene, force);
+  return force;
+}
+
+// Finds the contact of an existing contact force on the same ordered pair.
+// Only forces on the pair's bodies can match, so search the shorter of their
+// lists of forces. Forces on one pair are usually registered together, so
+// search backwards.
+contact_t *scene_find_contact(body_t *body1, body_t *body2) {
+  list_t *forces = body_get_forces(body1);
+  if (list_size(body_get_forces(body2)) < list_size(forces)) {
+    forces = body_get_forces(body2);
+  }
+  for (size_t i = list_size(forces); i > 0; i--) {
+    force_t *force = list_get(forces, i - 1);
+    if (force->is_contact && list_get(force->bodies, 0) == body1 &&
+        list_get(force->bodies, 1) == body2) {
+      return force->contact;
+    }
+  }
+  return NULL;
+}
+
+force_t *scene_add_contact_force_creator(scene_t *scene,
+                                         force_creator_t forcer, void *aux,
+                                         list_t *bodies, free_func_t freer) {
+  assert(list_size(bodies) == 2);
+  scene_assert_not_decorations(bodies);
+  body_t *body1 = list_get(bodies, 0);
+  body_t *body2 = list_get(bodies, 1);
+  force_t *force = force_init(scene->force_pool, forcer, aux, bodies, freer);
+  force->is_contact = true;
+  contact_t *contact = scene_find_contact(body1, body2);
+  force->contact = contact != NULL
+                       ? contact_retain(contact)
+                       : contact_init_in(scene->record_pool, body1, body2);
+  // Run on the first tick regardless, so the force sees the initial state
+  force->was_overlapping = true;
+  scene_add_force(scene, force);
+  scene->proxies_dirty = true;
+  return force;
+}
+
+void scene_remove_force_creator(scene_t *scene, force_t *force) {
+  assert(!force->removed);
+  force->removed = true;
+  force_unlink(force);
+  scene->forces_dirty = true;
+  scene->proxies_dirty |= force->is_contact;
+}
+
+// Frees the removed force creators, keeping the rest in order
+void scene_compact_forces(scene_t *scene) {
+  if (!scene->forces_dirty) {
+    return;
+  }
+  list_t *forces = scene->forces;
+  size_t kept = 0;
+  for (size_t i = 0; i < list_size(forces); i++) {
+    force_t *force = list_get(forces, i);
+    if (force->removed) {
+      force_free(force);
+    } else {
+      list_set(forces, kept++, force);
+    }
+  }
+  while (list_size(forces) > kept) {
+    list_remove(forces, list_size(forces) - 1);
+  }
+  scene->forces_dirty = false;
+}
+
+// Finds the body's proxy, or adds one. The body remembers its proxy's index,
+// so each lookup takes O(1) and rebuilding the proxies takes linear time.
+proxy_t *scene_get_proxy(scene_t *scene, body_t *body) {
+  size_t index = body_get_proxy_index(body);
+  if (index < scene->num_proxies && scene->proxies[index].body == body) {
+    return &scene->proxies[index];
+  }
+  if (scene->num_proxies == scene->proxy_capacity) {
+    scene->proxy_capacity *= 2;
+    scene->proxies =
+        realloc(scene->proxies, scene->proxy_capacity * sizeof(proxy_t));
+    assert(scene->proxies != NULL);
+  }
+  body_set_proxy_index(body, scene->num_proxies);
+  proxy_t *proxy = &scene->proxies[scene->num_proxies++];
+  *proxy = (proxy_t){.body = body, .contacts = list_init(1, NULL)};
+  return proxy;
+}
+
+void scene_rebuild_proxies(scene_t *scene) {
+  scene_clear_proxies(scene);
+  for (size_t i = 0; i < list_size(scene->forces); i++) {
+    force_t *force = list_get(scene->forces, i);
+    if (force->is_contact) {
+      list_add(scene_get_proxy(scene, list_get(force->bodies, 0))->contacts,
+               force);
+      list_add(scene_get_proxy(scene, list_get(force->bodies, 1))->contacts,
+               force);
+    }
+  }
+  scene->proxies_dirty = false;
+}
+
+// Flags the contact forces between the bodies of two overlapping proxies
+void scene_mark_overlap(scene_t *scene, proxy_t *proxy1, proxy_t *proxy2) {
+  if (list_size(proxy2->contacts) < list_size(proxy1->contacts)) {
+    proxy_t *temp = proxy1;
+    proxy1 = proxy2;
+    proxy2 = temp;
+  }
+  for (size_t i = 0; i < list_size(proxy1->contacts); i++) {
+    force_t *force = list_get(proxy1->contacts, i);
+    if (list_get(force->bodies, 0) == proxy2->body ||
+        list_get(force->bodies, 1) == proxy2->body) {
+      force->overlap_tick = scene->ticks;
+    }
+  }
 }
 
-void scene_add_bodies_force_creator(scene_t *scene, force_creator_t forcer,
-                                    void *aux, list_t *bodies,
-                                    free_func_t freer) {
-  list_add(scene->forces, force_init(forcer, aux, bodies, freer));
+// Sweep and prune: sorts the proxies along x, then only compares proxies
+// whose x intervals overlap. The order barely changes between ticks,
+// so the insertion sort runs in close to linear time.
+void scene_update_broadphase(scene_t *scene) {
+  if (scene->proxies_dirty) {
+    scene_rebuild_proxies(scene);
+  }
+  proxy_t *proxies = scene->proxies;
+  for (size_t i = 0; i < scene->num_proxies; i++) {
+    proxies[i].bounds = body_get_bounds(proxies[i].body);
+  }
+  for (size_t i = 1; i < scene->num_proxies; i++) {
+    proxy_t proxy = proxies[i];
+    size_t j = i;
+    for (; j > 0 && proxies[j - 1].bounds.min.x > proxy.bounds.min.x; j--) {
+      proxies[j] = proxies[j - 1];
+    }
+    proxies[j] = proxy;
+  }
+  for (size_t i = 0; i < scene->num_proxies; i++) {
+    for (size_t j = i + 1; j < scene->num_proxies &&
+                           proxies[j].bounds.min.x <= proxies[i].bounds.max.x;
+         j++) {
+      if (aabb_overlaps(proxies[i].bounds, proxies[j].bounds)) {
+        scene_mark_overlap(scene, &proxies[i], &proxies[j]);
+      }
+    }
+  }
+}
+
+arena_t *scene_get_scratch(scene_t *scene) { return scene->scratch; }
+
+arena_t *scene_get_body_arena(scene_t *scene) { return scene->body_arena; }
+
+void *scene_alloc_record(scene_t *scene, size_t size) {
+  assert(size <= pool_record_size(scene->record_pool));
+  return pool_alloc(scene->record_pool);
+}
+
+// Whether body, at its current position, collides with any of the candidates
+bool bullet_hits(body_t *body, body_t **candidates, size_t num_candidates) {
+  for (size_t i = 0; i < num_candidates; i++) {
+    if (find_body_collision(body, candidates[i]).collided) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Moves a bullet back from its new position to the first point on the
+// straight path from start where it hits a contact partner it did not
+// already touch at start. The path is sampled every half body width along
+// the direction of motion, then the hit is refined by bisection.
+void scene_sweep_bullet(scene_t *scene, body_t *body, vector_t start) {
+  vector_t end = body_get_centroid(body);
+  vector_t displacement = vec_subtract(end, start);
+  double distance = vec_magn(displacement);
+  if (distance == 0.0) {
+    return;
+  }
+  double min, max;
+  polygon_project(body_get_polygon(body),
+                  vec_multiply(1 / distance, displacement), &min, &max);
+  double step = (max - min) / 2;
+  list_t *forces = body_get_forces(body);
+  // A body with no width along its motion can't be sampled; that would take
+  // infinitely many steps
+  if (step <= 0 || distance <= step || list_size(forces) == 0) {
+    return;
+  }
+
+  // Contact partners in the box swept by the body, not touched at start
+  aabb_t bounds = body_get_bounds(body);
+  aabb_t swept = {
+      .min = {fmin(bounds.min.x, bounds.min.x - displacement.x),
+              fmin(bounds.min.y, bounds.min.y - displacement.y)},
+      .max = {fmax(bounds.max.x, bounds.max.x - displacement.x),
+              fmax(bounds.max.y, bounds.max.y - displacement.y)}};
+  body_t **candidates =
+      arena_alloc(scene->scratch, sizeof(body_t *) * list_size(forces));
+  size_t num_candidates = 0;
+  body_set_centroid(body, start);
+  for (size_t i = 0; i < list_size(forces); i++) {
+    force_t *force = list_get(forces, i);
+    if (!force->is_contact || force->removed) {
+      continue;
+    }
+    body_t *other = contact_get_body1(force->contact);
+    if (other == body) {
+      other = contact_get_body2(force->contact);
+    }
+    bool seen = false;
+    for (size_t j = 0; j < num_candidates && !seen; j++) {
+      seen = candidates[j] == other;
+    }
+    if (!seen && !body_is_removed(other) &&
+        aabb_overlaps(swept, body_get_bounds(other)) &&
+        !find_body_collision(body, other).collided) {
+      candidates[num_candidates++] = other;
+    }
+  }
+
+  size_t steps = ceil(distance / step);
+  for (size_t i = 1; i <= steps && num_candidates > 0; i++) {
+    double t = fmin(1.0, i * step / distance);
+    body_set_centroid(body, vec_add(start, vec_multiply(t, displacement)));
+    if (!bullet_hits(body, candidates, num_candidates)) {
+      continue;
+    }
+    double lo = (i - 1) * step / distance;
+    double hi = t;
+    for (size_t j = 0; j < BULLET_BISECTIONS; j++) {
+      double mid = (lo + hi) / 2;
+      body_set_centroid(body, vec_add(start, vec_multiply(mid, displacement)));
+      if (bullet_hits(body, candidates, num_candidates)) {
+        hi = mid;
+      } else {
+        lo = mid;
+      }
+    }
+    // Just touching, so the contact forces see the hit on the next tick
+    body_set_centroid(body, vec_add(start, vec_multiply(hi, displacement)));
+    return;
+  }
+  body_set_centroid(body, end);
 }
 
 void scene_tick(scene_t *scene, double dt) {
+  scene->ticks++;
+  arena_reset(scene->scratch);
+  scene_compact_forces(scene);
+  scene_update_broadphase(scene);
+
   // ticking force creators
   for (size_t i = 0; i < list_size(scene->forces); i++) {
     force_t *force = list_get(scene->forces, i);
+    if (force->removed) {
+      continue;
+    }
+    if (force->is_contact) {
+      // Contact forces also run on the tick after their bodies separate,
+      // so they can see that the bodies are no longer touching
+      bool overlapping = force->overlap_tick == scene->ticks;
+      bool was_overlapping = force->was_overlapping;
+      force->was_overlapping = overlapping;
+      if (!overlapping && !was_overlapping) {
+        continue;
+      }
+    }
     force->forcer(force->aux);
   }
 
-  // removing force creators
-  for (int32_t i = list_size(scene->forces) - 1; i >= 0; i--) {
-    force_t *force = list_get(scene->forces, i);
-    list_t *bodies = force->bodies;
-    for (int32_t j = list_size(bodies) - 1; j >= 0; j--) {
-      body_t *body = list_get(bodies, j);
-      if (body_is_removed(body)) {
-        force = list_remove(scene->forces, i);
-        force_free(force);
-        break;
-      }
+  // ticking bodies; static bodies never move, so they are skipped
+  for (int32_t i = list_size(scene->moving_bodies) - 1; i >= 0; i--) {
+    body_t *body = list_get(scene->moving_bodies, i);
+    if (body_is_removed(body)) {
+      list_remove(scene->moving_bodies, i);
+    } else if (body_is_bullet(body)) {
+      vector_t start = body_get_centroid(body);
+      body_tick(body, dt);
+      scene_sweep_bullet(scene, body, start);
+    } else {
+      body_tick(body, dt);
     }
   }
 
-  // ticking bodies
+  // freeing removed bodies, along with the force creators acting on them
   for (int32_t i = scene_bodies(scene) - 1; i >= 0; i--) {
     body_t *body = scene_get_body(scene, i);
     if (body_is_removed(body)) {
+      list_t *forces = body_get_forces(body);
+      while (list_size(forces) > 0) {
+        scene_remove_force_creator(scene,
+                                   list_get(forces, list_size(forces) - 1));
+      }
       body = list_remove(scene->bodies, i);
       body_free(body);
-    } else {
-      body_tick(body, dt);
     }
   }
+  scene_compact_forces(scene);
 }
 
 void scene_remove_force(scene_t *scene, force_creator_t force_type) {
   list_t *forces = scene->forces;
-  for (int16_t i = list_size(forces) - 1; i >= 0; i--) {
+  for (size_t i = 0; i < list_size(forces); i++) {
     force_t *force = list_get(forces, i);
-    if (force->forcer == force_type) {
-      list_remove(forces, i);
+    if (force->forcer == force_type && !force->removed) {
+      scene_remove_force_creator(scene, force);
     }
   }
 }
 
+// Removes an element from a list of unloaded bodies or forces in O(n),
+// by moving the last element into its slot. Asserts that it is in the list.
+void scene_forget_unloaded(list_t *unloaded, void *element) {
+  size_t size = list_size(unloaded);
+  for (size_t i = 0; i < size; i++) {
+    if (list_get(unloaded, i) == element) {
+      void *last = list_remove(unloaded, size - 1);
+      if (i < size - 1) {
+        list_set(unloaded, i, last);
+      }
+      return;
+    }
+  }
+  assert(false && "only bodies and forces unloaded from the scene can load");
+}
+
 void scene_unload_bodies(scene_t *scene, list_t *bodies, list_t *forces) {
+  scene_compact_forces(scene);
   size_t force_len = list_size(scene->forces);
   for (size_t i = 0; i < force_len; i++) {
     force_t *force = list_remove(scene->forces, 0);
+    force_unlink(force);
     list_add(forces, force);
+    list_add(scene->unloaded_forces, force);
   }
   size_t body_len = list_size(scene->bodies);
   for (size_t i = 0; i < body_len; i++) {
     body_t *body = list_remove(scene->bodies, 0);
     list_add(bodies, body);
+    list_add(scene->unloaded_bodies, body);
+  }
+  while (list_size(scene->moving_bodies) > 0) {
+    list_remove(scene->moving_bodies, list_size(scene->moving_bodies) - 1);
   }
+  scene->proxies_dirty = true;
 }
 
 void scene_load_bodies(scene_t *scene, list_t *bodies, list_t *forces) {
   size_t force_len = list_size(forces);
   for (size_t i = 0; i < force_len; i++) {
     force_t *force = list_remove(forces, 0);
-    list_add(scene->forces, force);
+    scene_forget_unloaded(scene->unloaded_forces, force);
+    scene_add_force(scene, force);
   }
   size_t body_len = list_size(bodies);
   for (size_t i = 0; i < body_len; i++) {
     body_t *body = list_remove(bodies, 0);
-    list_add(scene->bodies, body);
+    scene_forget_unloaded(scene->unloaded_bodies, body);
+    scene_add_body(scene, body);
   }
+  scene->proxies_dirty = true;
 }
\ No newline at end of file
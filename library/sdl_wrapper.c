@@ -15,6 +15,7 @@ const char WINDOW_TITLE[] = "CS 3";
 const int WINDOW_WIDTH = 1000;
 const int WINDOW_HEIGHT = 500;
 const double MS_PER_S = 1e3;
+const size_t FRAME_ARENA_SIZE = 1 << 16;
 
 Mix_Chunk *idle;
 Mix_Chunk *acc;
@@ -58,17 +59,17 @@ clock_t last_clock = 0;
 
 list_t *text_list;
 list_t *image_list;
+/**
+ * Scratch memory for drawing, reset by sdl_clear() at the start of every frame.
+ */
+arena_t *frame_arena;
 #define FONT_PATH_SIZE 60
 
 /** Computes the center of the window in pixel coordinates */
 vector_t get_window_center(void) {
-  int *width = malloc(sizeof(*width)), *height = malloc(sizeof(*height));
-  assert(width != NULL);
-  assert(height != NULL);
-  SDL_GetWindowSize(window, width, height);
-  vector_t dimensions = {.x = *width, .y = *height};
-  free(width);
-  free(height);
+  int width, height;
+  SDL_GetWindowSize(window, &width, &height);
+  vector_t dimensions = {.x = width, .y = height};
   return vec_multiply(0.5, dimensions);
 }
 
@@ -168,17 +169,16 @@ void sdl_init(vector_t min, vector_t max) {
   renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_PRESENTVSYNC);
   text_list = list_init(1, (free_func_t)free_text);
   image_list = list_init(1, (free_func_t)free_image);
+  frame_arena = arena_init(FRAME_ARENA_SIZE);
 }
 
 void sdl_move_window(vector_t position) { center = position; }
 
 bool sdl_is_done(state_t *state) {
-  SDL_Event *event = malloc(sizeof(*event));
-  assert(event != NULL);
-  while (SDL_PollEvent(event)) {
-    switch (event->type) {
+  SDL_Event event;
+  while (SDL_PollEvent(&event)) {
+    switch (event.type) {
     case SDL_QUIT:
-      free(event);
       return true;
     case SDL_KEYDOWN:
     case SDL_KEYUP:
@@ -186,16 +186,16 @@ bool sdl_is_done(state_t *state) {
       // or an unrecognized key was pressed
       if (key_handler == NULL)
         break;
-      char key = get_keycode(event->key.keysym.sym);
+      char key = get_keycode(event.key.keysym.sym);
       if (key == '\0')
         break;
 
-      uint32_t timestamp = event->key.timestamp;
-      if (!event->key.repeat) {
+      uint32_t timestamp = event.key.timestamp;
+      if (!event.key.repeat) {
         key_start_timestamp = timestamp;
       }
       key_event_type_t type =
-          event->type == SDL_KEYDOWN ? KEY_PRESSED : KEY_RELEASED;
+          event.type == SDL_KEYDOWN ? KEY_PRESSED : KEY_RELEASED;
       double held_time = (timestamp - key_start_timestamp) / MS_PER_S;
       key_handler(state, key, type, held_time);
       break;
@@ -203,14 +203,14 @@ bool sdl_is_done(state_t *state) {
     case SDL_MOUSEBUTTONUP:
       if (mouse_handler == NULL)
         break;
-      char mouse_button = get_mousecode(event->button.button);
+      char mouse_button = get_mousecode(event.button.button);
       if (mouse_button == 0)
         break;
-      mouse_event_type_t mouse_type = event->type == SDL_MOUSEBUTTONDOWN
+      mouse_event_type_t mouse_type = event.type == SDL_MOUSEBUTTONDOWN
                                           ? MOUSE_BUTTON_PRESSED
                                           : MOUSE_BUTTON_RELEASED;
       vector_t window_center = get_window_center();
-      vector_t pixel = (vector_t){event->button.x, event->button.y};
+      vector_t pixel = (vector_t){event.button.x, event.button.y};
       vector_t scene_pos = get_scene_position(pixel, window_center);
       double x_scale = window_center.x / max_diff.x;
       mouse_handler(state, mouse_button, mouse_type,
@@ -218,7 +218,6 @@ bool sdl_is_done(state_t *state) {
       break;
     }
   }
-  free(event);
   return false;
 }
 
@@ -352,13 +351,23 @@ void sound_play(sound_t sound) {
 }
 
 void sdl_clear(void) {
+  // Every frame starts with a clear, so the last frame's scratch is done
+  arena_reset(frame_arena);
   SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
   SDL_RenderClear(renderer);
 }
 
 void sdl_draw_polygon(list_t *points, rgb_color_t color) {
+  polygon_t *shape = polygon_init_in(frame_arena, list_size(points));
+  for (size_t i = 0; i < list_size(points); i++) {
+    polygon_add_vertex(shape, *(vector_t *)list_get(points, i));
+  }
+  sdl_draw_shape(shape, color);
+}
+
+void sdl_draw_shape(const polygon_t *shape, rgb_color_t color) {
   // Check parameters
-  size_t n = list_size(points);
+  size_t n = polygon_size(shape);
   assert(n >= 3);
   assert(0 <= color.r && color.r <= 1);
   assert(0 <= color.g && color.g <= 1);
@@ -367,13 +376,13 @@ void sdl_draw_polygon(list_t *points, rgb_color_t color) {
   vector_t window_center = get_window_center();
 
   // Convert each vertex to a point on screen
-  int16_t *x_points = malloc(sizeof(*x_points) * n),
-          *y_points = malloc(sizeof(*y_points) * n);
-  assert(x_points != NULL);
-  assert(y_points != NULL);
+  int16_t *x_points = arena_alloc(frame_arena, sizeof(*x_points) * n),
+          *y_points = arena_alloc(frame_arena, sizeof(*y_points) * n);
+  const double *xs = polygon_get_xs(shape);
+  const double *ys = polygon_get_ys(shape);
   for (size_t i = 0; i < n; i++) {
-    vector_t *vertex = list_get(points, i);
-    vector_t pixel = get_window_position(*vertex, window_center);
+    vector_t pixel =
+        get_window_position((vector_t){xs[i], ys[i]}, window_center);
     x_points[i] = pixel.x;
     y_points[i] = pixel.y;
   }
@@ -381,8 +390,20 @@ void sdl_draw_polygon(list_t *points, rgb_color_t color) {
   // Draw polygon with the given color
   filledPolygonRGBA(renderer, x_points, y_points, n, color.r * 255,
                     color.g * 255, color.b * 255, 255);
-  free(x_points);
-  free(y_points);
+}
+
+void sdl_draw_circle(vector_t circle_center, double radius,
+                     rgb_color_t color) {
+  assert(radius > 0);
+  assert(0 <= color.r && color.r <= 1);
+  assert(0 <= color.g && color.g <= 1);
+  assert(0 <= color.b && color.b <= 1);
+
+  vector_t window_center = get_window_center();
+  vector_t pixel = get_window_position(circle_center, window_center);
+  double pixel_radius = round(radius * get_scene_scale(window_center));
+  filledCircleRGBA(renderer, pixel.x, pixel.y, pixel_radius, color.r * 255,
+                   color.g * 255, color.b * 255, 255);
 }
 
 void sdl_show(void) {
@@ -392,14 +413,12 @@ void sdl_show(void) {
            min = vec_subtract(center, max_diff);
   vector_t max_pixel = get_window_position(max, window_center),
            min_pixel = get_window_position(min, window_center);
-  SDL_Rect *boundary = malloc(sizeof(*boundary));
-  boundary->x = min_pixel.x;
-  boundary->y = max_pixel.y;
-  boundary->w = max_pixel.x - min_pixel.x;
-  boundary->h = min_pixel.y - max_pixel.y;
+  SDL_Rect boundary = {.x = min_pixel.x,
+                       .y = max_pixel.y,
+                       .w = max_pixel.x - min_pixel.x,
+                       .h = min_pixel.y - max_pixel.y};
   SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-  SDL_RenderDrawRect(renderer, boundary);
-  free(boundary);
+  SDL_RenderDrawRect(renderer, &boundary);
 
   SDL_RenderPresent(renderer);
 }
@@ -413,9 +432,12 @@ void sdl_render_scene(scene_t *scene) {
   }
   for (size_t i = 0; i < body_count; i++) {
     body_t *body = scene_get_body(scene, i);
-    list_t *shape = body_get_shape(body);
-    sdl_draw_polygon(shape, body_get_color(body));
-    list_free(shape);
+    if (body_is_circle(body)) {
+      sdl_draw_circle(body_get_centroid(body), body_get_radius(body),
+                      body_get_color(body));
+    } else {
+      sdl_draw_shape(body_get_polygon(body), body_get_color(body));
+    }
   }
   for (size_t i = 0; i < list_size(text_list); i++) {
     text_t *text = list_get(text_list, i);
@@ -0,0 +1,293 @@
+#include "bike.h"
+#include "body.h"
+#include "chain.h"
+#include "collision.h"
+#include "heightfield.h"
+#include "list.h"
+#include "polygon.h"
+#include "vector.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// Sizes used by the game: the bike is scaled up by 10 and each track
+// segment is a quad scaled up by 90.
+const double BENCH_BIKE_SCALE = 10.0;
+const double BENCH_TRACK_SCALE = 90.0;
+const size_t BENCH_ITERATIONS = 20000;
+// The game's wheels: 250 vertices around a radius of 18
+const size_t BENCH_WHEEL_POINTS = 250;
+const double BENCH_WHEEL_RADIUS = 18.0;
+
+list_t *make_bench_bike(vector_t position) {
+  list_t *shape = make_bike_shape();
+  for (size_t i = 0; i < list_size(shape); i++) {
+    vector_t *v = list_get(shape, i);
+    *v = vec_multiply(BENCH_BIKE_SCALE, *v);
+  }
+  polygon_translate(shape, vec_subtract(position, polygon_centroid(shape)));
+  return shape;
+}
+
+// The first segment of track one
+list_t *make_bench_quad() {
+  vector_t corners[] = {{0, 0}, {84.46, 0}, {84.46, 5}, {0, 5}};
+  list_t *quad = list_init(4, free);
+  for (size_t i = 0; i < 4; i++) {
+    vector_t *v = malloc(sizeof(*v));
+    *v = vec_multiply(BENCH_TRACK_SCALE, corners[i]);
+    list_add(quad, v);
+  }
+  return quad;
+}
+
+void bench_pair(const char *name, list_t *bike, list_t *quad) {
+  polygon_t *bike_polygon = polygon_from_list(bike);
+  polygon_t *quad_polygon = polygon_from_list(quad);
+  size_t collisions = 0;
+  clock_t start = clock();
+  for (size_t i = 0; i < BENCH_ITERATIONS; i++) {
+    collisions += find_polygon_collision(bike_polygon, quad_polygon).collided;
+  }
+  double polygon_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+  start = clock();
+  for (size_t i = 0; i < BENCH_ITERATIONS; i++) {
+    collisions += find_collision(bike, quad).collided;
+  }
+  double list_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+  // Bodies test their cached, deduplicated unit normals
+  body_t *bike_body =
+      body_init(polygon_to_list(bike_polygon), 1, (rgb_color_t){0, 0, 0});
+  body_t *quad_body =
+      body_init_static(polygon_to_list(quad_polygon), (rgb_color_t){0, 0, 0});
+  start = clock();
+  for (size_t i = 0; i < BENCH_ITERATIONS; i++) {
+    collisions += find_body_collision(bike_body, quad_body).collided;
+  }
+  double body_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+  printf("%-24s %8.3f us/call  (list API %8.3f us/call, bodies %8.3f "
+         "us/call, %zu hits)\n",
+         name, polygon_time / BENCH_ITERATIONS * 1e6,
+         list_time / BENCH_ITERATIONS * 1e6,
+         body_time / BENCH_ITERATIONS * 1e6, collisions);
+  body_free(bike_body);
+  body_free(quad_body);
+  polygon_free(bike_polygon);
+  polygon_free(quad_polygon);
+}
+
+// A flat track of num_segments quads, 100 wide, as separate bodies, as one
+// heightfield and as one chain, with the bike resting on it
+void bench_track(size_t num_segments) {
+  double top = 5 * BENCH_TRACK_SCALE;
+  list_t *samples = list_init(num_segments + 1, free);
+  list_t *vertices = list_init(num_segments + 1, free);
+  body_t **quads = malloc(sizeof(body_t *) * num_segments);
+  for (size_t i = 0; i <= num_segments; i++) {
+    vector_t *sample = malloc(sizeof(*sample));
+    *sample = (vector_t){100.0 * i, top};
+    list_add(samples, sample);
+    vector_t *vertex = malloc(sizeof(*vertex));
+    *vertex = *sample;
+    list_add(vertices, vertex);
+    if (i < num_segments) {
+      vector_t corners[] = {
+          {100.0 * i, 0}, {100.0 * i, top}, {100.0 * (i + 1), top},
+          {100.0 * (i + 1), 0}};
+      list_t *quad = list_init(4, free);
+      for (size_t k = 0; k < 4; k++) {
+        vector_t *v = malloc(sizeof(*v));
+        *v = corners[k];
+        list_add(quad, v);
+      }
+      quads[i] = body_init_static(quad, (rgb_color_t){0, 0, 0});
+    }
+  }
+  body_t *heightfield = body_init_heightfield(heightfield_init(samples, 0),
+                                              (rgb_color_t){0, 0, 0}, NULL,
+                                              NULL);
+  body_t *chain = body_init_chain(chain_init(vertices, false),
+                                  (rgb_color_t){0, 0, 0}, NULL, NULL);
+  body_t *bike = body_init(make_bench_bike((vector_t){1050, top + 30}), 1,
+                           (rgb_color_t){0, 0, 0});
+  size_t collisions = 0;
+  clock_t start = clock();
+  for (size_t i = 0; i < BENCH_ITERATIONS; i++) {
+    for (size_t j = 0; j < num_segments; j++) {
+      collisions += find_body_collision(bike, quads[j]).collided;
+    }
+  }
+  double quads_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+  start = clock();
+  for (size_t i = 0; i < BENCH_ITERATIONS; i++) {
+    collisions += find_body_collision(bike, heightfield).collided;
+  }
+  double heightfield_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+  start = clock();
+  for (size_t i = 0; i < BENCH_ITERATIONS; i++) {
+    collisions += find_body_collision(bike, chain).collided;
+  }
+  double chain_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+  printf("bike on %4zu-segment track %8.3f us/tick as quads, %8.3f as a "
+         "heightfield, %8.3f as a chain  (%zu hits)\n",
+         num_segments, quads_time / BENCH_ITERATIONS * 1e6,
+         heightfield_time / BENCH_ITERATIONS * 1e6,
+         chain_time / BENCH_ITERATIONS * 1e6, collisions);
+  for (size_t j = 0; j < num_segments; j++) {
+    body_free(quads[j]);
+  }
+  free(quads);
+  body_free(heightfield);
+  body_free(chain);
+  body_free(bike);
+}
+
+// A wheel sunk 1 into a track quad, as a many-sided polygon and as a circle
+void bench_wheel(list_t *quad) {
+  double top = 5 * BENCH_TRACK_SCALE;
+  vector_t center = {1000, top + BENCH_WHEEL_RADIUS - 1};
+  list_t *points = list_init(BENCH_WHEEL_POINTS, free);
+  for (size_t i = 0; i < BENCH_WHEEL_POINTS; i++) {
+    vector_t *v = malloc(sizeof(*v));
+    *v = vec_add(center, vec_rotate((vector_t){BENCH_WHEEL_RADIUS, 0},
+                                    2 * M_PI * i / BENCH_WHEEL_POINTS));
+    list_add(points, v);
+  }
+  body_t *polygon = body_init(points, 1, (rgb_color_t){0, 0, 0});
+  body_t *circle = body_init_circle(center, BENCH_WHEEL_RADIUS, 1,
+                                    (rgb_color_t){0, 0, 0}, NULL, NULL);
+  polygon_t *quad_polygon = polygon_from_list(quad);
+  body_t *quad_body =
+      body_init_static(polygon_to_list(quad_polygon), (rgb_color_t){0, 0, 0});
+  polygon_free(quad_polygon);
+  size_t collisions = 0;
+  clock_t start = clock();
+  for (size_t i = 0; i < BENCH_ITERATIONS; i++) {
+    collisions += find_body_collision(polygon, quad_body).collided;
+  }
+  double polygon_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+  start = clock();
+  for (size_t i = 0; i < BENCH_ITERATIONS; i++) {
+    collisions += find_body_collision(circle, quad_body).collided;
+  }
+  double circle_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+  printf("wheel resting on quad    %8.3f us/call as a %zu-gon, %8.3f as a "
+         "circle  (%zu hits)\n",
+         polygon_time / BENCH_ITERATIONS * 1e6, BENCH_WHEEL_POINTS,
+         circle_time / BENCH_ITERATIONS * 1e6, collisions);
+  body_free(polygon);
+  body_free(circle);
+  body_free(quad_body);
+}
+
+// The game's 250-sided wheel against a track quad, sunk 1 into it and 1
+// above it, with the separating axis test and with GJK
+void bench_gjk(list_t *quad) {
+  double top = 5 * BENCH_TRACK_SCALE;
+  polygon_t *quad_polygon = polygon_from_list(quad);
+  polygon_t *wheel = polygon_init(BENCH_WHEEL_POINTS);
+  for (size_t i = 0; i < BENCH_WHEEL_POINTS; i++) {
+    polygon_add_vertex(
+        wheel, vec_add((vector_t){1000, top + BENCH_WHEEL_RADIUS - 1},
+                       vec_rotate((vector_t){BENCH_WHEEL_RADIUS, 0},
+                                  2 * M_PI * i / BENCH_WHEEL_POINTS)));
+  }
+  for (size_t k = 0; k < 2; k++) {
+    size_t collisions = 0;
+    clock_t start = clock();
+    for (size_t i = 0; i < BENCH_ITERATIONS; i++) {
+      collisions += find_polygon_collision(wheel, quad_polygon).collided;
+    }
+    double sat_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+    start = clock();
+    for (size_t i = 0; i < BENCH_ITERATIONS; i++) {
+      collisions += find_convex_distance(support_polygon(wheel, 0),
+                                         support_polygon(quad_polygon, 0))
+                        .collided;
+    }
+    double gjk_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+    printf("%-24s %8.3f us/call with SAT, %8.3f with GJK  (%zu hits)\n",
+           k == 0 ? "250-gon sunk into quad" : "250-gon just above quad",
+           sat_time / BENCH_ITERATIONS * 1e6,
+           gjk_time / BENCH_ITERATIONS * 1e6, collisions);
+    polygon_translate_vertices(wheel, (vector_t){0, 2});
+  }
+  polygon_free(wheel);
+  polygon_free(quad_polygon);
+}
+
+// Two of the game's wheels overlapping by 1, with the list API's full
+// projections and with bodies climbing to each axis' extreme vertices
+void bench_climb() {
+  list_t *points[2];
+  for (size_t k = 0; k < 2; k++) {
+    vector_t center = {k * (2 * BENCH_WHEEL_RADIUS - 1), 0};
+    points[k] = list_init(BENCH_WHEEL_POINTS, free);
+    for (size_t i = 0; i < BENCH_WHEEL_POINTS; i++) {
+      vector_t *v = malloc(sizeof(*v));
+      *v = vec_add(center, vec_rotate((vector_t){BENCH_WHEEL_RADIUS, 0},
+                                      2 * M_PI * (i + 0.5 * k) /
+                                          BENCH_WHEEL_POINTS));
+      list_add(points[k], v);
+    }
+  }
+  polygon_t *polygon1 = polygon_from_list(points[0]);
+  polygon_t *polygon2 = polygon_from_list(points[1]);
+  body_t *body1 = body_init(polygon_to_list(polygon1), 1, (rgb_color_t){0});
+  body_t *body2 = body_init(polygon_to_list(polygon2), 1, (rgb_color_t){0});
+  polygon_free(polygon1);
+  polygon_free(polygon2);
+  size_t collisions = 0;
+  clock_t start = clock();
+  for (size_t i = 0; i < BENCH_ITERATIONS; i++) {
+    collisions += find_collision(points[0], points[1]).collided;
+  }
+  double list_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+  start = clock();
+  for (size_t i = 0; i < BENCH_ITERATIONS; i++) {
+    collisions += find_body_collision(body1, body2).collided;
+  }
+  double body_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+  printf("250-gon vs 250-gon       %8.3f us/call with lists, %8.3f with "
+         "bodies  (%zu hits)\n",
+         list_time / BENCH_ITERATIONS * 1e6,
+         body_time / BENCH_ITERATIONS * 1e6, collisions);
+  list_free(points[0]);
+  list_free(points[1]);
+  body_free(body1);
+  body_free(body2);
+}
+
+int main() {
+  list_t *quad = make_bench_quad();
+  double top = 5 * BENCH_TRACK_SCALE;
+  list_t *bike = make_bench_bike(VEC_ZERO);
+  printf("bike (%zu vertices) vs track quad, %zu iterations\n",
+         list_size(bike), BENCH_ITERATIONS);
+  list_free(bike);
+
+  // Resting on the track: every axis overlaps, so all are tested
+  bike = make_bench_bike((vector_t){1000, top + 30});
+  bench_pair("bike resting on quad", bike, quad);
+  list_free(bike);
+
+  // Just above the track: separated, but only by a few pixels
+  bike = make_bench_bike((vector_t){1000, top + 60});
+  bench_pair("bike just above quad", bike, quad);
+  list_free(bike);
+
+  // Far away: almost any axis separates the shapes
+  bike = make_bench_bike((vector_t){-2000, top + 1000});
+  bench_pair("bike far from quad", bike, quad);
+  list_free(bike);
+
+  bench_wheel(quad);
+  bench_gjk(quad);
+  bench_climb();
+  list_free(quad);
+
+  // The game's tracks have about 60 segments
+  bench_track(60);
+  bench_track(1000);
+}
@@ -0,0 +1,71 @@
+#include "arena.h"
+#include "test_util.h"
+#include <assert.h>
+#include <stdalign.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+void test_arena_alloc() {
+  arena_t *arena = arena_init(64);
+  assert(arena_used(arena) == 0);
+  char *c = arena_alloc(arena, 1);
+  double *d = arena_alloc(arena, 3 * sizeof(double));
+  // Every allocation is aligned, and none of them overlap
+  assert((uintptr_t)c % alignof(max_align_t) == 0);
+  assert((uintptr_t)d % alignof(max_align_t) == 0);
+  assert((char *)d >= c + 1);
+  *c = 'a';
+  d[0] = 1.0;
+  d[2] = 3.0;
+  assert(*c == 'a');
+  assert(arena_used(arena) >= 1 + 3 * sizeof(double));
+  arena_free(arena);
+}
+
+void test_arena_grow() {
+  arena_t *arena = arena_init(16);
+  int *small = arena_alloc(arena, sizeof(int));
+  *small = 7;
+  // Outgrowing the block keeps the earlier allocations valid
+  char *big = arena_alloc(arena, 1000);
+  memset(big, 'x', 1000);
+  assert(*small == 7);
+  size_t used = arena_used(arena);
+  assert(used >= 1000 + sizeof(int));
+
+  // After a reset, the same allocations fit in a single block
+  arena_reset(arena);
+  assert(arena_used(arena) == 0);
+  char *first = arena_alloc(arena, sizeof(int));
+  char *second = arena_alloc(arena, 1000);
+  assert(second > first && second - first < 1000);
+  assert(arena_used(arena) == used);
+  arena_free(arena);
+}
+
+void test_arena_reset() {
+  arena_t *arena = arena_init(128);
+  void *first = arena_alloc(arena, 32);
+  arena_alloc(arena, 32);
+  arena_reset(arena);
+  // The memory is reused from the start of the block
+  assert(arena_alloc(arena, 32) == first);
+  arena_free(arena);
+}
+
+int main(int argc, char *argv[]) {
+  // Run all tests if there are no command-line arguments
+  bool all_tests = argc == 1;
+  // Read test name from file
+  char testname[100];
+  if (!all_tests) {
+    read_testname(argv[1], testname, sizeof(testname));
+  }
+
+  DO_TEST(test_arena_alloc)
+  DO_TEST(test_arena_grow)
+  DO_TEST(test_arena_reset)
+
+  puts("arena_test PASS");
+}
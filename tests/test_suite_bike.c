@@ -0,0 +1,95 @@
+#include "bike.h"
+#include "polygon.h"
+#include "test_util.h"
+#include "vector.h"
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+void test_bike_shape() {
+  list_t *shape = make_bike_shape();
+  assert(list_size(shape) > 400 && list_size(shape) <= 500);
+  // Counterclockwise, so the area is positive
+  assert(polygon_area(shape) > 0);
+  for (size_t i = 0; i < list_size(shape); i++) {
+    vector_t *v = list_get(shape, i);
+    assert(v->x >= -8.6 && v->x <= 4.5);
+    assert(v->y >= -3 && v->y <= 5.5);
+  }
+  list_free(shape);
+}
+
+void test_bike_decomposition() {
+  list_t *shape = make_bike_shape();
+  polygon_t *polygon = polygon_from_list(shape);
+  list_t *parts = polygon_decompose(polygon);
+  // Each part needs only a handful of axes instead of one per outline edge
+  size_t max_part_size = 0;
+  double area = 0;
+  for (size_t i = 0; i < list_size(parts); i++) {
+    polygon_t *part = list_get(parts, i);
+    assert(polygon_is_convex(part));
+    max_part_size = fmax(max_part_size, polygon_size(part));
+    area += polygon_get_area(part);
+  }
+  assert(list_size(parts) > 1);
+  assert(max_part_size * 10 < polygon_size(polygon));
+  // The outline crosses itself in a few places, so the areas differ slightly
+  assert(fabs(area - polygon_get_area(polygon)) < 0.01);
+  list_free(parts);
+  polygon_free(polygon);
+  list_free(shape);
+}
+
+// Largest distance from a vertex of polygon to the outline of simplified
+double max_deviation(const polygon_t *polygon, const polygon_t *simplified) {
+  double result = 0;
+  size_t size = polygon_size(simplified);
+  for (size_t i = 0; i < polygon_size(polygon); i++) {
+    vector_t vertex = polygon_get_vertex(polygon, i);
+    double distance = INFINITY;
+    for (size_t j = 0; j < size; j++) {
+      vector_t a = polygon_get_vertex(simplified, j);
+      vector_t b = polygon_get_vertex(simplified, (j + 1) % size);
+      vector_t edge = vec_subtract(b, a);
+      double t = vec_dot(vec_subtract(vertex, a), edge) / vec_dot(edge, edge);
+      vector_t closest = vec_add(a, vec_multiply(fmax(0, fmin(1, t)), edge));
+      distance = fmin(distance, vec_magn(vec_subtract(vertex, closest)));
+    }
+    result = fmax(result, distance);
+  }
+  return result;
+}
+
+void test_bike_simplification() {
+  // The tolerance the game uses, in the bike's unscaled units
+  const double tolerance = 0.025;
+  list_t *shape = make_bike_shape();
+  polygon_t *polygon = polygon_from_list(shape);
+  polygon_t *simplified = polygon_simplify(polygon, tolerance);
+  double deviation = max_deviation(polygon, simplified);
+  printf("bike simplified from %zu to %zu vertices, max deviation %.4f\n",
+         polygon_size(polygon), polygon_size(simplified), deviation);
+  assert(polygon_size(simplified) * 2 < polygon_size(polygon));
+  assert(deviation <= tolerance);
+  polygon_free(simplified);
+  polygon_free(polygon);
+  list_free(shape);
+}
+
+int main(int argc, char *argv[]) {
+  // Run all tests if there are no command-line arguments
+  bool all_tests = argc == 1;
+  // Read test name from file
+  char testname[100];
+  if (!all_tests) {
+    read_testname(argv[1], testname, sizeof(testname));
+  }
+
+  DO_TEST(test_bike_shape)
+  DO_TEST(test_bike_decomposition)
+  DO_TEST(test_bike_simplification)
+
+  puts("bike_test PASS");
+}
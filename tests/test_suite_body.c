@@ -30,6 +30,329 @@ void test_body_init() {
   body_free(body);
 }
 
+void test_body_get_polygon() {
+  vector_t v[] = {{1, 1}, {2, 1}, {2, 2}, {1, 2}};
+  const size_t VERTICES = sizeof(v) / sizeof(*v);
+  list_t *shape = list_init(0, free);
+  for (size_t i = 0; i < VERTICES; i++) {
+    vector_t *list_v = malloc(sizeof(*list_v));
+    *list_v = v[i];
+    list_add(shape, list_v);
+  }
+  body_t *body = body_init(shape, 1, (rgb_color_t){0, 0, 0});
+  const polygon_t *polygon = body_get_polygon(body);
+  assert(body_get_polygon(body) == polygon);
+  assert(polygon_size(polygon) == VERTICES);
+  for (size_t i = 0; i < VERTICES; i++) {
+    assert(vec_isclose(polygon_get_vertex(polygon, i), v[i]));
+  }
+  body_set_centroid(body, (vector_t){3.5, 1.5});
+  polygon = body_get_polygon(body);
+  for (size_t i = 0; i < VERTICES; i++) {
+    assert(vec_isclose(polygon_get_vertex(polygon, i),
+                       vec_add(v[i], (vector_t){2, 0})));
+  }
+  // Rotating about a pivot moves the vertices but not the centroid
+  body_set_pivot(body, (vector_t){3, 1});
+  body_rotate(body, M_PI);
+  assert(vec_isclose(body_get_centroid(body), (vector_t){3.5, 1.5}));
+  polygon = body_get_polygon(body);
+  vector_t rotated[] = {{3, 1}, {2, 1}, {2, 0}, {3, 0}};
+  for (size_t i = 0; i < VERTICES; i++) {
+    assert(vec_isclose(polygon_get_vertex(polygon, i), rotated[i]));
+  }
+  body_free(body);
+}
+
+void test_body_bounds() {
+  vector_t v[] = {{0, 0}, {4, 0}, {4, 2}, {0, 2}};
+  list_t *shape = list_init(4, free);
+  for (size_t i = 0; i < 4; i++) {
+    vector_t *list_v = malloc(sizeof(*list_v));
+    *list_v = v[i];
+    list_add(shape, list_v);
+  }
+  body_t *body = body_init(shape, 1, (rgb_color_t){0, 0, 0});
+  assert(isclose(body_get_bounding_radius(body), sqrt(5)));
+  body_set_centroid(body, (vector_t){10, 10});
+  aabb_t bounds = body_get_bounds(body);
+  assert(vec_isclose(bounds.min, (vector_t){8, 9}));
+  assert(vec_isclose(bounds.max, (vector_t){12, 11}));
+
+  // Rotated bounds must still contain every vertex
+  for (size_t i = 1; i <= 8; i++) {
+    body_set_rotation(body, i * M_PI / 7);
+    bounds = body_get_bounds(body);
+    const polygon_t *polygon = body_get_polygon(body);
+    for (size_t j = 0; j < polygon_size(polygon); j++) {
+      vector_t vertex = polygon_get_vertex(polygon, j);
+      assert(vertex.x >= bounds.min.x - 1e-9);
+      assert(vertex.x <= bounds.max.x + 1e-9);
+      assert(vertex.y >= bounds.min.y - 1e-9);
+      assert(vertex.y <= bounds.max.y + 1e-9);
+    }
+    assert(bounds.max.x - bounds.min.x <= 2 * sqrt(5) + 1e-9);
+  }
+  body_set_rotation(body, M_PI / 2);
+  bounds = body_get_bounds(body);
+  assert(vec_isclose(bounds.min, (vector_t){9, 8}));
+  assert(vec_isclose(bounds.max, (vector_t){11, 12}));
+  body_free(body);
+}
+
+void test_body_normals() {
+  vector_t v[] = {{0, 0}, {4, 0}, {4, 2}, {0, 2}};
+  list_t *shape = list_init(4, free);
+  for (size_t i = 0; i < 4; i++) {
+    vector_t *list_v = malloc(sizeof(*list_v));
+    *list_v = v[i];
+    list_add(shape, list_v);
+  }
+  body_t *body = body_init(shape, 1, (rgb_color_t){0, 0, 0});
+  const polygon_t *normals = body_get_normals(body);
+  assert(polygon_size(normals) == 2);
+  assert(vec_isclose(polygon_get_vertex(normals, 0), (vector_t){0, 1}));
+  assert(vec_isclose(polygon_get_vertex(normals, 1), (vector_t){-1, 0}));
+  // Moving doesn't change the normals, but rotating does
+  body_set_centroid(body, (vector_t){10, 10});
+  assert(vec_isclose(polygon_get_vertex(body_get_normals(body), 0),
+                     (vector_t){0, 1}));
+  body_set_rotation(body, M_PI / 2);
+  normals = body_get_normals(body);
+  assert(vec_isclose(polygon_get_vertex(normals, 0), (vector_t){-1, 0}));
+  assert(vec_isclose(polygon_get_vertex(normals, 1), (vector_t){0, -1}));
+
+  // A new shape brings new normals
+  list_t *triangle = list_init(3, free);
+  vector_t t[] = {{0, 0}, {1, 0}, {0, 1}};
+  for (size_t i = 0; i < 3; i++) {
+    vector_t *list_v = malloc(sizeof(*list_v));
+    *list_v = t[i];
+    list_add(triangle, list_v);
+  }
+  body_set_polygon(body, triangle);
+  assert(polygon_size(body_get_normals(body)) == 3);
+  body_free(body);
+}
+
+list_t *make_square() {
+  vector_t v[] = {{-1, -1}, {1, -1}, {1, 1}, {-1, 1}};
+  list_t *shape = list_init(4, free);
+  for (size_t i = 0; i < 4; i++) {
+    vector_t *list_v = malloc(sizeof(*list_v));
+    *list_v = v[i];
+    list_add(shape, list_v);
+  }
+  return shape;
+}
+
+void test_body_parts() {
+  // A U shape, which needs at least 3 convex parts
+  vector_t v[] = {{0, 0}, {3, 0}, {3, 3}, {2, 3},
+                  {2, 1}, {1, 1}, {1, 3}, {0, 3}};
+  list_t *shape = list_init(8, free);
+  for (size_t i = 0; i < 8; i++) {
+    vector_t *list_v = malloc(sizeof(*list_v));
+    *list_v = v[i];
+    list_add(shape, list_v);
+  }
+  body_t *body = body_init(shape, 1, (rgb_color_t){0, 0, 0});
+  size_t num_parts = body_get_num_parts(body);
+  assert(num_parts >= 3);
+  body_set_centroid(body, vec_add(body_get_centroid(body), (vector_t){5, 0}));
+  body_set_rotation(body, M_PI);
+  aabb_t bounds = polygon_get_bounds(body_get_polygon(body));
+  double area = 0;
+  for (size_t i = 0; i < num_parts; i++) {
+    // Parts move with the body
+    aabb_t part_bounds = polygon_get_bounds(body_get_part(body, i));
+    assert(part_bounds.min.x >= bounds.min.x - 1e-9);
+    assert(part_bounds.max.y <= bounds.max.y + 1e-9);
+    area += polygon_get_area(body_get_part(body, i));
+    const polygon_t *normals = body_get_part_normals(body, i);
+    for (size_t j = 0; j < polygon_size(normals); j++) {
+      assert(isclose(vec_magn(polygon_get_vertex(normals, j)), 1));
+    }
+  }
+  assert(isclose(area, 7));
+
+  // Convex bodies are a single part: the whole polygon
+  body_set_polygon(body, make_square());
+  assert(body_get_num_parts(body) == 1);
+  assert(body_get_part(body, 0) == body_get_polygon(body));
+  assert(body_get_part_normals(body, 0) == body_get_normals(body));
+  body_free(body);
+}
+
+void test_body_collision_tolerance() {
+  // A square with many vertices along each side
+  list_t *shape = list_init(40, free);
+  for (size_t side = 0; side < 4; side++) {
+    for (size_t i = 0; i < 10; i++) {
+      vector_t corners[] = {{-1, -1}, {1, -1}, {1, 1}, {-1, 1}};
+      vector_t *v = malloc(sizeof(*v));
+      *v = vec_add(corners[side],
+                   vec_multiply(i / 10.0, vec_subtract(corners[(side + 1) % 4],
+                                                       corners[side])));
+      list_add(shape, v);
+    }
+  }
+  body_t *body = body_init(shape, 1, (rgb_color_t){0, 0, 0});
+  body_set_collision_tolerance(body, 0.01);
+  body_set_centroid(body, (vector_t){3, 4});
+  // Drawn in full detail, but collides as the 4 corners
+  assert(polygon_size(body_get_polygon(body)) == 40);
+  assert(body_get_num_parts(body) == 1);
+  const polygon_t *part = body_get_part(body, 0);
+  assert(polygon_size(part) == 4);
+  assert(vec_isclose(polygon_get_vertex(part, 0), (vector_t){2, 3}));
+  assert(polygon_size(body_get_part_normals(body, 0)) == 2);
+  // Turning the tolerance off goes back to the outline
+  body_set_collision_tolerance(body, 0);
+  assert(body_get_part(body, 0) == body_get_polygon(body));
+  body_free(body);
+}
+
+void test_motion_types() {
+  rgb_color_t color = {0, 0, 0};
+  body_t *dynamic = body_init(make_square(), 1, color);
+  body_t *kinematic = body_init_kinematic(make_square(), color);
+  body_t *fixed = body_init_static(make_square(), color);
+  assert(body_get_motion_type(dynamic) == MOTION_DYNAMIC);
+  assert(body_get_motion_type(kinematic) == MOTION_KINEMATIC);
+  assert(body_get_motion_type(fixed) == MOTION_STATIC);
+  assert(body_get_mass(fixed) == INFINITY);
+  assert(!body_is_decoration(fixed));
+  body_t *decoration = body_init_decoration(make_square(), color);
+  assert(body_is_decoration(decoration));
+  assert(body_get_motion_type(decoration) == MOTION_STATIC);
+  assert(body_get_mass(decoration) == INFINITY);
+  body_free(decoration);
+  body_t *bodies[] = {dynamic, kinematic, fixed};
+  for (size_t i = 0; i < 3; i++) {
+    body_set_velocity(bodies[i], (vector_t){1, 0});
+    body_add_force(bodies[i], (vector_t){0, 2});
+    body_tick(bodies[i], 1);
+  }
+  // Only the dynamic body feels the force; the static body ignores velocity
+  assert(vec_isclose(body_get_centroid(dynamic), (vector_t){1, 1}));
+  assert(vec_isclose(body_get_velocity(dynamic), (vector_t){1, 2}));
+  assert(vec_isclose(body_get_centroid(kinematic), (vector_t){1, 0}));
+  assert(vec_isclose(body_get_velocity(kinematic), (vector_t){1, 0}));
+  assert(vec_isclose(body_get_centroid(fixed), VEC_ZERO));
+  for (size_t i = 0; i < 3; i++) {
+    body_free(bodies[i]);
+  }
+}
+
+void test_heightfield_body() {
+  // Samples at x = 0, 10, ..., 1000, alternating between heights 5 and 6
+  list_t *samples = list_init(101, free);
+  for (size_t i = 0; i <= 100; i++) {
+    vector_t *sample = malloc(sizeof(*sample));
+    *sample = (vector_t){10.0 * i, 5.0 + i % 2};
+    list_add(samples, sample);
+  }
+  body_t *body = body_init_heightfield(heightfield_init(samples, 0),
+                                       (rgb_color_t){0, 0, 0}, NULL, NULL);
+  assert(body_get_motion_type(body) == MOTION_STATIC);
+  assert(body_get_num_parts(body) == 100);
+  assert(isclose(polygon_get_area(body_get_polygon(body)), 1000 * 5.5));
+  vector_t corners[] = {{430, 0}, {430, 6}, {440, 5}, {440, 0}};
+  for (size_t i = 0; i < 4; i++) {
+    assert(vec_isclose(polygon_get_vertex(body_get_part(body, 43), i),
+                       corners[i]));
+  }
+
+  // Only the columns under the box are found
+  aabb_t box = {.min = {435, 5}, .max = {455, 7}};
+  size_t first, end;
+  body_find_parts(body, box, &first, &end);
+  assert(first == 43 && end == 46);
+
+  // Moving the body moves the columns with it
+  body_set_centroid(body, vec_add(body_get_centroid(body), (vector_t){20, 1}));
+  assert(vec_isclose(polygon_get_vertex(body_get_part(body, 43), 1),
+                     (vector_t){450, 7}));
+  body_find_parts(body, box, &first, &end);
+  assert(first == 41 && end == 44);
+
+  // Rotated heightfields fall back to every part
+  body_set_rotation(body, 0.1);
+  body_find_parts(body, box, &first, &end);
+  assert(first == 0 && end == 100);
+  body_free(body);
+}
+
+void test_body_arena() {
+  arena_t *arena = arena_init(64);
+  rgb_color_t color = {0, 0, 0};
+  size_t *info = malloc(sizeof(*info));
+  *info = 7;
+  body_t *body =
+      body_init_with_info_in(arena, make_square(), 1, color, info, free);
+  body_t *decoration = body_init_decoration_in(arena, make_square(), color);
+  list_t *samples = list_init(3, free);
+  for (size_t i = 0; i < 3; i++) {
+    vector_t *sample = malloc(sizeof(*sample));
+    *sample = (vector_t){10.0 * i, 5.0};
+    list_add(samples, sample);
+  }
+  body_t *ground = body_init_heightfield_in(
+      arena, heightfield_init(samples, 0), color, NULL, NULL);
+  assert(body_is_decoration(decoration));
+  assert(body_get_motion_type(ground) == MOTION_STATIC);
+  assert(*(size_t *)body_get_info(body) == 7);
+  size_t used = arena_used(arena);
+  assert(used > 0);
+
+  // Collision shapes found later come from the arena too
+  body_set_collision_tolerance(body, 0.01);
+  body_set_centroid(body, (vector_t){3, 4});
+  assert(body_get_num_parts(body) == 1);
+  assert(vec_isclose(polygon_get_vertex(body_get_part(body, 0), 0),
+                     (vector_t){2, 3}));
+  assert(polygon_size(body_get_normals(body)) == 2);
+  assert(body_get_num_parts(ground) == 2);
+  assert(arena_used(arena) > used);
+
+  // Freeing the bodies frees their info and heightfields, and the arena
+  // releases the rest
+  body_free(body);
+  body_free(decoration);
+  body_free(ground);
+  arena_free(arena);
+}
+
+void test_circle_body() {
+  body_t *body = body_init_circle((vector_t){10, 20}, 2, 3,
+                                  (rgb_color_t){0, 0, 0}, NULL, NULL);
+  assert(body_is_circle(body));
+  assert(isclose(body_get_radius(body), 2));
+  assert(vec_isclose(body_get_centroid(body), (vector_t){10, 20}));
+  // A uniform disc
+  assert(isclose(body_get_moment_of_inertia(body), 0.5 * 3 * 2 * 2));
+  // The outline's vertices are on the circle, and its box is the circle's
+  const polygon_t *outline = body_get_polygon(body);
+  for (size_t i = 0; i < polygon_size(outline); i++) {
+    vector_t offset =
+        vec_subtract(polygon_get_vertex(outline, i), (vector_t){10, 20});
+    assert(isclose(vec_magn(offset), 2));
+  }
+  aabb_t bounds = body_get_bounds(body);
+  assert(vec_isclose(bounds.min, (vector_t){8, 18}));
+  assert(vec_isclose(bounds.max, (vector_t){12, 22}));
+  // Rotating the circle leaves its box alone
+  body_set_rotation(body, 0.3);
+  bounds = body_get_bounds(body);
+  assert(vec_isclose(bounds.min, (vector_t){8, 18}));
+  // Given a polygon, the body stops being a circle
+  body_set_polygon(body, body_get_shape(body));
+  assert(!body_is_circle(body));
+  assert(body_get_radius(body) == 0);
+  body_free(body);
+}
+
 void test_body_setters() {
   list_t *shape = list_init(3, free);
   vector_t *v = malloc(sizeof(*v));
@@ -258,6 +581,15 @@ int main(int argc, char *argv[]) {
   }
 
   DO_TEST(test_body_init)
+  DO_TEST(test_body_get_polygon)
+  DO_TEST(test_body_bounds)
+  DO_TEST(test_body_normals)
+  DO_TEST(test_motion_types)
+  DO_TEST(test_body_parts)
+  DO_TEST(test_body_collision_tolerance)
+  DO_TEST(test_heightfield_body)
+  DO_TEST(test_body_arena)
+  DO_TEST(test_circle_body)
   DO_TEST(test_body_setters)
   DO_TEST(test_body_tick)
   DO_TEST(test_infinite_mass)
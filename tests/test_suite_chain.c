@@ -0,0 +1,110 @@
+#include "chain.h"
+#include "list.h"
+#include "polygon.h"
+#include "test_util.h"
+#include <assert.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+list_t *make_vertices(const vector_t *vertices, size_t size) {
+  list_t *list = list_init(size, free);
+  for (size_t i = 0; i < size; i++) {
+    vector_t *v = malloc(sizeof(*v));
+    *v = vertices[i];
+    list_add(list, v);
+  }
+  return list;
+}
+
+// A zigzag of num_segments segments, each 10 wide, from x = 0
+chain_t *make_zigzag(size_t num_segments) {
+  list_t *vertices = list_init(num_segments + 1, free);
+  for (size_t i = 0; i <= num_segments; i++) {
+    vector_t *v = malloc(sizeof(*v));
+    *v = (vector_t){10.0 * i, i % 2};
+    list_add(vertices, v);
+  }
+  return chain_init(vertices, false);
+}
+
+void test_chain_segments() {
+  vector_t square[] = {{0, 0}, {0, 1}, {1, 1}, {1, 0}};
+  chain_t *open = chain_init(make_vertices(square, 4), false);
+  chain_t *closed = chain_init(make_vertices(square, 4), true);
+  assert(chain_num_segments(open) == 3);
+  assert(chain_num_segments(closed) == 4);
+  vector_t start, end;
+  chain_get_segment(closed, 3, &start, &end);
+  assert(vec_equal(start, (vector_t){1, 0}));
+  assert(vec_equal(end, (vector_t){0, 0}));
+  // Listed clockwise, the square's segments face outwards
+  assert(vec_isclose(chain_get_segment_normal(closed, 1), (vector_t){0, 1}));
+  assert(vec_isclose(chain_get_segment_normal(closed, 3), (vector_t){0, -1}));
+  aabb_t bounds = chain_get_bounds(open);
+  assert(vec_equal(bounds.min, VEC_ZERO));
+  assert(vec_equal(bounds.max, (vector_t){1, 1}));
+  chain_free(open);
+  chain_free(closed);
+}
+
+void test_chain_vertex_normals() {
+  // Flat, then a 90 degree turn downwards
+  vector_t corner[] = {{-1, 0}, {0, 0}, {0, -1}};
+  chain_t *chain = chain_init(make_vertices(corner, 3), false);
+  assert(vec_isclose(chain_get_vertex_normal(chain, 0), (vector_t){0, 1}));
+  assert(vec_isclose(chain_get_vertex_normal(chain, 1),
+                     (vector_t){M_SQRT1_2, M_SQRT1_2}));
+  assert(vec_isclose(chain_get_vertex_normal(chain, 2), (vector_t){1, 0}));
+  chain_free(chain);
+
+  // A closed triangle's first vertex also joins its last segment
+  vector_t triangle[] = {{0, 0}, {0, 1}, {1, 0}};
+  chain = chain_init(make_vertices(triangle, 3), true);
+  assert(vec_isclose(chain_get_vertex_normal(chain, 0),
+                     (vector_t){-M_SQRT1_2, -M_SQRT1_2}));
+  chain_free(chain);
+}
+
+void count_segment(size_t segment, void *aux) {
+  size_t *found = aux;
+  found[0]++;
+  found[1 + segment % 2]++;
+  found[3] = segment < found[3] ? segment : found[3];
+  found[4] = segment > found[4] ? segment : found[4];
+}
+
+void test_chain_query() {
+  chain_t *chain = make_zigzag(10000);
+  // Segments 123 and 124 cover x = 1230 to 1250
+  size_t found[] = {0, 0, 0, SIZE_MAX, 0};
+  chain_query(chain, (aabb_t){{1235, -1}, {1245, 2}}, count_segment, found);
+  assert(found[0] == 2 && found[3] == 123 && found[4] == 124);
+  // Every segment, each visited once
+  size_t all[] = {0, 0, 0, SIZE_MAX, 0};
+  chain_query(chain, chain_get_bounds(chain), count_segment, all);
+  assert(all[0] == 10000 && all[1] == 5000 && all[2] == 5000);
+  assert(all[3] == 0 && all[4] == 9999);
+  // Boxes that miss every segment
+  size_t none[] = {0, 0, 0, SIZE_MAX, 0};
+  chain_query(chain, (aabb_t){{500, 2}, {600, 3}}, count_segment, none);
+  chain_query(chain, (aabb_t){{-50, 0}, {-1, 1}}, count_segment, none);
+  assert(none[0] == 0);
+  chain_free(chain);
+}
+
+int main(int argc, char *argv[]) {
+  // Run all tests if there are no command-line arguments
+  bool all_tests = argc == 1;
+  // Read test name from file
+  char testname[100];
+  if (!all_tests) {
+    read_testname(argv[1], testname, sizeof(testname));
+  }
+
+  DO_TEST(test_chain_segments)
+  DO_TEST(test_chain_vertex_normals)
+  DO_TEST(test_chain_query)
+
+  puts("chain_test PASS");
+}
@@ -70,6 +70,528 @@ void test_colliding() {
   scene_free(scene);
 }
 
+void test_body_collision() {
+  body_t *triangle = body_init(make_triangle(), 1, (rgb_color_t){0, 0, 0});
+  body_t *trapezoid = body_init(make_trapezoid(), 1, (rgb_color_t){0, 0, 0});
+  list_t *triangle_shape = body_get_shape(triangle);
+  list_t *trapezoid_shape = body_get_shape(trapezoid);
+  collision_info_t expected = find_collision(triangle_shape, trapezoid_shape);
+  collision_info_t collision = find_body_collision(triangle, trapezoid);
+  assert(collision.collided == expected.collided);
+  body_set_centroid(trapezoid, vec_subtract(body_get_centroid(trapezoid),
+                                            (vector_t){0.75, 0}));
+  collision = find_body_collision(triangle, trapezoid);
+  assert(collision.collided);
+  list_free(trapezoid_shape);
+  trapezoid_shape = body_get_shape(trapezoid);
+  expected = find_collision(triangle_shape, trapezoid_shape);
+  // Bodies report the same axis, normalized
+  assert(isclose(vec_magn(collision.axis), 1));
+  assert(vec_isclose(collision.axis,
+                     vec_multiply(1 / vec_magn(expected.axis), expected.axis)));
+
+  // Far apart: rejected by the bounding boxes
+  body_set_centroid(trapezoid, (vector_t){100, 100});
+  assert(!find_body_collision(triangle, trapezoid).collided);
+  list_free(triangle_shape);
+  list_free(trapezoid_shape);
+  body_free(triangle);
+  body_free(trapezoid);
+}
+
+void test_concave_collision() {
+  // An L whose corner is empty
+  vector_t l[] = {{0, 0}, {4, 0}, {4, 1}, {1, 1}, {1, 4}, {0, 4}};
+  list_t *l_shape = list_init(6, free);
+  for (size_t i = 0; i < 6; i++) {
+    vector_t *v = malloc(sizeof(*v));
+    *v = l[i];
+    list_add(l_shape, v);
+  }
+  body_t *body = body_init(l_shape, 1, (rgb_color_t){0, 0, 0});
+  assert(body_get_num_parts(body) == 2);
+  // A box in the corner overlaps the L's outline on every axis, but touches
+  // neither of its parts
+  list_t *box_shape = list_init(4, free);
+  vector_t box[] = {{2, 2}, {3, 2}, {3, 3}, {2, 3}};
+  for (size_t i = 0; i < 4; i++) {
+    vector_t *v = malloc(sizeof(*v));
+    *v = box[i];
+    list_add(box_shape, v);
+  }
+  list_t *outline = body_get_shape(body);
+  assert(find_collision(outline, box_shape).collided);
+  list_free(outline);
+  body_t *box_body = body_init(box_shape, 1, (rgb_color_t){0, 0, 0});
+  assert(!find_body_collision(body, box_body).collided);
+
+  // Moved onto the L's foot, the box hits the lower part
+  body_set_centroid(box_body, (vector_t){3, 1.25});
+  collision_info_t collision = find_body_collision(body, box_body);
+  assert(collision.collided);
+  assert(isclose(fabs(collision.axis.y), 1));
+  body_free(box_body);
+  body_free(body);
+}
+
+list_t *make_box(vector_t min, vector_t max) {
+  vector_t corners[] = {min, {max.x, min.y}, max, {min.x, max.y}};
+  list_t *box = list_init(4, free);
+  for (size_t i = 0; i < 4; i++) {
+    vector_t *v = malloc(sizeof(*v));
+    *v = corners[i];
+    list_add(box, v);
+  }
+  return box;
+}
+
+void test_contact_points() {
+  // A box sunk 0.1 into the middle of a wide floor touches along its bottom
+  list_t *floor = make_box((vector_t){-10, -1}, (vector_t){10, 0});
+  list_t *box = make_box((vector_t){-1, -0.1}, (vector_t){1, 1.9});
+  collision_info_t collision = find_collision(floor, box);
+  assert(collision.collided);
+  assert(isclose(collision.depth, 0.1));
+  assert(collision.num_contacts == 2);
+  for (size_t i = 0; i < 2; i++) {
+    assert(isclose(fabs(collision.contacts[i].x), 1));
+    assert(isclose(collision.contacts[i].y, -0.1));
+  }
+  list_free(box);
+
+  // A diamond pokes a single corner into the floor
+  list_t *diamond = list_init(4, free);
+  vector_t corners[] = {{0, -0.2}, {1, 0.8}, {0, 1.8}, {-1, 0.8}};
+  for (size_t i = 0; i < 4; i++) {
+    vector_t *v = malloc(sizeof(*v));
+    *v = corners[i];
+    list_add(diamond, v);
+  }
+  body_t *floor_body = body_init(floor, INFINITY, (rgb_color_t){0, 0, 0});
+  body_t *diamond_body = body_init(diamond, 1, (rgb_color_t){0, 0, 0});
+  collision = find_body_collision(floor_body, diamond_body);
+  assert(collision.collided);
+  assert(isclose(collision.depth, 0.2));
+  assert(vec_isclose(collision.contacts[0], (vector_t){0, -0.2}));
+  // Either order of the bodies finds the same point
+  collision = find_body_collision(diamond_body, floor_body);
+  assert(vec_isclose(collision.contacts[0], (vector_t){0, -0.2}));
+  body_free(diamond_body);
+  body_free(floor_body);
+}
+
+void test_contact_cache() {
+  body_t *triangle = body_init(make_triangle(), 1, (rgb_color_t){0, 0, 0});
+  body_t *trapezoid = body_init(make_trapezoid(), 1, (rgb_color_t){0, 0, 0});
+  contact_t *contact = contact_init(triangle, trapezoid);
+  assert(contact_get_body1(contact) == triangle);
+  assert(contact_get_body2(contact) == trapezoid);
+  size_t version = body_get_shape_version(trapezoid);
+  collision_info_t collision = contact_get_collision(contact);
+  assert(collision.collided ==
+         find_body_collision(triangle, trapezoid).collided);
+
+  // Moving either body invalidates the cached result
+  body_set_centroid(trapezoid, (vector_t){100, 100});
+  assert(body_get_shape_version(trapezoid) != version);
+  assert(!contact_get_collision(contact).collided);
+  body_set_centroid(trapezoid, VEC_ZERO);
+  body_set_centroid(triangle, VEC_ZERO);
+  collision = contact_get_collision(contact);
+  assert(collision.collided);
+  assert(vec_equal(collision.axis,
+                   find_body_collision(triangle, trapezoid).axis));
+
+  // Setting the same centroid leaves the shape, and the cache, unchanged
+  version = body_get_shape_version(triangle);
+  body_set_centroid(triangle, VEC_ZERO);
+  assert(body_get_shape_version(triangle) == version);
+
+  // The contact is only freed once every reference is dropped
+  assert(contact_retain(contact) == contact);
+  contact_free(contact);
+  assert(contact_get_collision(contact).collided);
+  contact_free(contact);
+  body_free(triangle);
+  body_free(trapezoid);
+}
+
+void test_separating_axis_cache() {
+  // The box sits in the triangle's bounding box, just past its hypotenuse
+  list_t *triangle_shape = list_init(3, free);
+  vector_t corners[] = {{0, 0}, {4, 0}, {0, 4}};
+  for (size_t i = 0; i < 3; i++) {
+    vector_t *v = malloc(sizeof(*v));
+    *v = corners[i];
+    list_add(triangle_shape, v);
+  }
+  body_t *triangle = body_init(triangle_shape, 1, (rgb_color_t){0, 0, 0});
+  body_t *box = body_init(make_box((vector_t){2.5, 2.5}, (vector_t){4, 4}), 1,
+                          (rgb_color_t){0, 0, 0});
+  contact_t *contact = contact_init(triangle, box);
+  collision_reset_axis_cache_stats();
+  assert(!contact_get_collision(contact).collided);
+  axis_cache_stats_t stats = collision_get_axis_cache_stats();
+  assert(stats.lookups == 0 && stats.hits == 0);
+
+  // Nudging the box along the hypotenuse leaves it apart on the cached axis
+  vector_t centroid = body_get_centroid(box);
+  body_set_centroid(box, vec_add(centroid, (vector_t){0.5, -0.5}));
+  assert(!contact_get_collision(contact).collided);
+  stats = collision_get_axis_cache_stats();
+  assert(stats.lookups == 1 && stats.hits == 1);
+
+  // Pushing it into the triangle misses, and the full test still runs
+  body_set_centroid(box, vec_add(body_get_centroid(box), (vector_t){-1, -1}));
+  collision_info_t collision = contact_get_collision(contact);
+  assert(collision.collided);
+  assert(vec_equal(collision.axis, find_body_collision(triangle, box).axis));
+  stats = collision_get_axis_cache_stats();
+  assert(stats.lookups == 2 && stats.hits == 1);
+
+  // Colliding clears the cached axis
+  body_set_centroid(box, vec_add(body_get_centroid(box), (vector_t){0.1, 0}));
+  assert(contact_get_collision(contact).collided);
+  assert(collision_get_axis_cache_stats().lookups == 2);
+  contact_free(contact);
+  body_free(triangle);
+  body_free(box);
+}
+
+void test_tolerance_contact_cache() {
+  // A slab with a thin bump on top, which a tolerance of 0.5 smooths away
+  list_t *slab_shape = list_init(7, free);
+  vector_t corners[] = {{0, 0}, {10, 0}, {10, 1}, {5.1, 1},
+                        {5, 1.2}, {4.9, 1}, {0, 1}};
+  for (size_t i = 0; i < 7; i++) {
+    vector_t *v = malloc(sizeof(*v));
+    *v = corners[i];
+    list_add(slab_shape, v);
+  }
+  body_t *slab = body_init(slab_shape, 1, (rgb_color_t){0, 0, 0});
+  // The box only touches the bump
+  body_t *box = body_init(make_box((vector_t){4.95, 1.1}, (vector_t){5.05, 2}),
+                          1, (rgb_color_t){0, 0, 0});
+  contact_t *contact = contact_init(slab, box);
+  assert(contact_get_collision(contact).collided);
+
+  // Changing the tolerance under a live contact invalidates its result
+  size_t version = body_get_shape_version(slab);
+  body_set_collision_tolerance(slab, 0.5);
+  assert(body_get_shape_version(slab) != version);
+  assert(!find_body_collision(slab, box).collided);
+  assert(!contact_get_collision(contact).collided);
+  body_set_collision_tolerance(slab, 0);
+  assert(contact_get_collision(contact).collided);
+  contact_free(contact);
+  body_free(slab);
+  body_free(box);
+}
+
+void test_large_part_collision() {
+  // A long straight edge under an apex, and a 250-gon: both are big enough
+  // that bodies climb to their extreme vertices rather than scan them
+  list_t *shapes[2] = {list_init(41, free), list_init(250, free)};
+  for (size_t i = 0; i < 40; i++) {
+    vector_t *v = malloc(sizeof(*v));
+    *v = (vector_t){5.0 * i / 39, 0};
+    list_add(shapes[0], v);
+  }
+  vector_t *apex = malloc(sizeof(*apex));
+  *apex = (vector_t){2.5, 1};
+  list_add(shapes[0], apex);
+  for (size_t i = 0; i < 250; i++) {
+    vector_t *v = malloc(sizeof(*v));
+    *v = vec_rotate((vector_t){3, 0}, 2 * M_PI * i / 250);
+    list_add(shapes[1], v);
+  }
+  srand(7);
+  for (size_t k = 0; k < 2; k++) {
+    body_t *body = body_init(shapes[k], 1, (rgb_color_t){0, 0, 0});
+    body_t *box = body_init(make_box((vector_t){0, 0}, (vector_t){0.5, 0.5}),
+                            1, (rgb_color_t){0, 0, 0});
+    contact_t *contact = contact_init(body, box);
+    for (size_t i = 0; i < 2000; i++) {
+      // Turned and moved in world space, where rounding dents straight runs
+      double angle = 2 * M_PI * rand() / RAND_MAX;
+      body_set_rotation(body, i % 2 == 0 ? angle : M_PI / 2 * (rand() % 4));
+      body_set_centroid(body, (vector_t){100.0 * rand() / RAND_MAX, -50});
+      // Near a vertex, where an interval cut short by a wrong extreme
+      // vertex would miss the box
+      list_t *body_shape = body_get_shape(body);
+      vector_t *vertex = list_get(body_shape, rand() % list_size(body_shape));
+      vector_t offset = {0.8 * rand() / RAND_MAX - 0.4,
+                         0.8 * rand() / RAND_MAX - 0.4};
+      body_set_centroid(box, vec_add(*vertex, offset));
+      list_t *box_shape = body_get_shape(box);
+      bool collided = find_collision(body_shape, box_shape).collided;
+      assert(find_body_collision(body, box).collided == collided);
+      assert(contact_get_collision(contact).collided == collided);
+      list_free(body_shape);
+      list_free(box_shape);
+    }
+    contact_free(contact);
+    body_free(body);
+    body_free(box);
+  }
+}
+
+void test_heightfield_collision() {
+  // A long, flat heightfield at height 10 with one bump at x = 5000
+  list_t *samples = list_init(1001, free);
+  for (size_t i = 0; i <= 1000; i++) {
+    vector_t *sample = malloc(sizeof(*sample));
+    *sample = (vector_t){10.0 * i, i == 500 ? 15 : 10};
+    list_add(samples, sample);
+  }
+  body_t *ground = body_init_heightfield(heightfield_init(samples, 0),
+                                         (rgb_color_t){0, 0, 0}, NULL, NULL);
+  // A box sunk 0.5 into the flat part collides along the vertical
+  body_t *box = body_init(make_box((vector_t){100, 9.5}, (vector_t){104, 12}),
+                          1, (rgb_color_t){0, 0, 0});
+  collision_info_t collision = find_body_collision(box, ground);
+  assert(collision.collided);
+  assert(isclose(fabs(collision.axis.y), 1));
+  assert(isclose(collision.depth, 0.5));
+  // Just above it, nothing collides
+  body_set_centroid(box, vec_add(body_get_centroid(box), (vector_t){0, 1}));
+  assert(!find_body_collision(box, ground).collided);
+  assert(!find_body_collision(ground, box).collided);
+  // The bump reaches above the flat ground
+  body_set_centroid(box, (vector_t){4998, 13.75});
+  assert(find_body_collision(ground, box).collided);
+  body_free(box);
+  body_free(ground);
+}
+
+void test_chain_collision() {
+  // Flat ground from x = 0 to 100, then a wall up to y = 50. Listed in
+  // this order, both face the space above the ground and left of the wall.
+  vector_t corners[] = {{0, 0}, {50, 0}, {100, 0}, {100, 50}};
+  list_t *vertices = list_init(4, free);
+  for (size_t i = 0; i < 4; i++) {
+    vector_t *v = malloc(sizeof(*v));
+    *v = corners[i];
+    list_add(vertices, v);
+  }
+  body_t *level = body_init_chain(chain_init(vertices, false),
+                                  (rgb_color_t){0, 0, 0}, NULL, NULL);
+  assert(body_get_chain(level) != NULL);
+  // A box sunk 0.5 into the ground is pushed straight up, even across the
+  // vertex at x = 50 where two segments meet
+  body_t *box = body_init(make_box((vector_t){48, -0.5}, (vector_t){52, 2}), 1,
+                          (rgb_color_t){0, 0, 0});
+  collision_info_t collision = find_body_collision(level, box);
+  assert(collision.collided);
+  assert(vec_isclose(collision.axis, (vector_t){0, 1}));
+  assert(isclose(collision.depth, 0.5));
+  assert(collision.num_contacts == 1);
+  assert(isclose(collision.contacts[0].y, -0.5));
+  // The axis points from the first body to the second
+  collision = find_body_collision(box, level);
+  assert(collision.collided);
+  assert(vec_isclose(collision.axis, (vector_t){0, -1}));
+  // Above the ground, nothing collides
+  body_set_centroid(box, (vector_t){50, 2});
+  assert(!find_body_collision(level, box).collided);
+  // Pressed into the wall, the box is pushed back to the left
+  body_set_centroid(box, (vector_t){99, 20});
+  collision = find_body_collision(level, box);
+  assert(collision.collided);
+  assert(vec_isclose(collision.axis, (vector_t){-1, 0}));
+  assert(isclose(collision.depth, 1));
+  // Segments only collide from the front: behind the wall, nothing does
+  body_set_centroid(box, (vector_t){101, 20});
+  assert(!find_body_collision(level, box).collided);
+  // Moving the level moves the chain with it
+  body_set_centroid(level, vec_add(body_get_centroid(level), (vector_t){2, 0}));
+  assert(find_body_collision(level, box).collided);
+  body_free(box);
+  body_free(level);
+}
+
+void test_circle_collision() {
+  rgb_color_t color = {0, 0, 0};
+  body_t *circle1 =
+      body_init_circle((vector_t){0, 0}, 2, 1, color, NULL, NULL);
+  body_t *circle2 =
+      body_init_circle((vector_t){3, 0}, 1.5, 1, color, NULL, NULL);
+  // Two circles overlap by the sum of their radii less the distance
+  collision_info_t collision = find_body_collision(circle1, circle2);
+  assert(collision.collided);
+  assert(vec_isclose(collision.axis, (vector_t){1, 0}));
+  assert(isclose(collision.depth, 0.5));
+  assert(vec_isclose(collision.contacts[0], (vector_t){1.75, 0}));
+  body_set_centroid(circle2, (vector_t){3, 3});
+  assert(!find_body_collision(circle1, circle2).collided);
+
+  // Against a box's face, the axis is the face's normal
+  body_t *box = body_init(make_box((vector_t){-5, -5}, (vector_t){5, -1.5}),
+                          1, color);
+  collision = find_body_collision(circle1, box);
+  assert(collision.collided);
+  assert(vec_isclose(collision.axis, (vector_t){0, -1}));
+  assert(isclose(collision.depth, 0.5));
+  assert(vec_isclose(collision.contacts[0], (vector_t){0, -1.5}));
+  // and it points from the first body to the second
+  collision = find_body_collision(box, circle1);
+  assert(vec_isclose(collision.axis, (vector_t){0, 1}));
+  // Near a corner, the axis runs from the corner to the center, so a
+  // circle whose bounding box overlaps the box's can still miss it
+  body_set_centroid(circle1, (vector_t){6.2, 0.2});
+  assert(!find_body_collision(circle1, box).collided);
+  body_set_centroid(circle1, (vector_t){5.9, -0.3});
+  collision = find_body_collision(box, circle1);
+  assert(collision.collided);
+  assert(vec_isclose(collision.axis, (vector_t){0.6, 0.8}));
+  assert(isclose(collision.depth, 0.5));
+  assert(vec_isclose(collision.contacts[0], (vector_t){5, -1.5}));
+  // With its center inside the box, the circle leaves by the nearest face
+  body_set_centroid(circle1, (vector_t){4, -3});
+  collision = find_body_collision(box, circle1);
+  assert(collision.collided);
+  assert(vec_isclose(collision.axis, (vector_t){1, 0}));
+  assert(isclose(collision.depth, 3));
+
+  // A circle rolling on a chain is pushed out along the segment's normal
+  list_t *vertices = list_init(2, free);
+  vector_t *v = malloc(sizeof(*v));
+  *v = (vector_t){0, -20};
+  list_add(vertices, v);
+  v = malloc(sizeof(*v));
+  *v = (vector_t){100, -20};
+  list_add(vertices, v);
+  body_t *ground = body_init_chain(chain_init(vertices, false), color, NULL,
+                                   NULL);
+  body_set_centroid(circle2, (vector_t){50, -18.75});
+  collision = find_body_collision(ground, circle2);
+  assert(collision.collided);
+  assert(vec_isclose(collision.axis, (vector_t){0, 1}));
+  assert(isclose(collision.depth, 0.25));
+  body_set_centroid(circle2, (vector_t){50, -21});
+  assert(!find_body_collision(ground, circle2).collided);
+  body_free(ground);
+  body_free(box);
+  body_free(circle1);
+  body_free(circle2);
+}
+
+polygon_t *make_box_polygon(vector_t min, vector_t max) {
+  list_t *box = make_box(min, max);
+  polygon_t *polygon = polygon_from_list(box);
+  list_free(box);
+  return polygon;
+}
+
+void test_convex_distance() {
+  polygon_t *box1 = make_box_polygon((vector_t){0, 0}, (vector_t){2, 2});
+  polygon_t *box2 = make_box_polygon((vector_t){5, 1}, (vector_t){7, 3});
+  // Apart, the closest points are on the facing edges
+  distance_info_t distance = find_convex_distance(support_polygon(box1, 0),
+                                                  support_polygon(box2, 0));
+  assert(!distance.collided);
+  assert(isclose(distance.distance, 3));
+  assert(vec_isclose(distance.axis, (vector_t){1, 0}));
+  assert(isclose(distance.point1.x, 2) && isclose(distance.point2.x, 5));
+  assert(isclose(distance.point1.y, distance.point2.y));
+  // Grown polygons are rounded off by the radius
+  distance = find_convex_distance(support_polygon(box1, 0.5),
+                                  support_polygon(box2, 1));
+  assert(isclose(distance.distance, 1.5));
+  assert(isclose(distance.point1.x, 2.5) && isclose(distance.point2.x, 4));
+
+  // Overlapping, the depth and axis agree with the separating axis test
+  polygon_t *box3 = make_box_polygon((vector_t){1.5, 0.5}, (vector_t){4, 1.5});
+  distance = find_convex_distance(support_polygon(box1, 0),
+                                  support_polygon(box3, 0));
+  collision_info_t collision = find_polygon_collision(box1, box3);
+  assert(distance.collided);
+  assert(isclose(distance.distance, -collision.depth));
+  assert(isclose(distance.distance, -0.5));
+  assert(vec_isclose(distance.axis, (vector_t){1, 0}));
+  assert(isclose(distance.point1.x, 2) && isclose(distance.point2.x, 1.5));
+
+  // Circles are points with a radius
+  vector_t center1 = {0, 0};
+  vector_t center2 = {3, 4};
+  distance = find_convex_distance(support_point(&center1, 1),
+                                  support_point(&center2, 2));
+  assert(isclose(distance.distance, 2));
+  assert(vec_isclose(distance.axis, (vector_t){0.6, 0.8}));
+  assert(vec_isclose(distance.point1, (vector_t){0.6, 0.8}));
+  assert(vec_isclose(distance.point2, (vector_t){1.8, 2.4}));
+  // A circle whose center is inside a box leaves by the nearest edge
+  vector_t center3 = {1, 1.2};
+  distance = find_convex_distance(support_point(&center3, 0.5),
+                                  support_polygon(box1, 0));
+  assert(distance.collided);
+  assert(isclose(distance.distance, -1.3));
+  assert(vec_isclose(distance.axis, (vector_t){0, -1}));
+
+  // Capsules are segments with a radius
+  segment_t segment = {{0, 5}, {10, 5}};
+  polygon_t *post = make_box_polygon((vector_t){4, 0}, (vector_t){6, 3});
+  distance = find_convex_distance(support_segment(&segment, 1),
+                                  support_polygon(post, 0));
+  assert(!distance.collided);
+  assert(isclose(distance.distance, 1));
+  assert(vec_isclose(distance.axis, (vector_t){0, -1}));
+  distance = find_convex_distance(support_polygon(post, 0),
+                                  support_segment(&segment, 2.5));
+  assert(distance.collided);
+  assert(isclose(distance.distance, -0.5));
+  assert(vec_isclose(distance.axis, (vector_t){0, 1}));
+  // Touching shapes collide at distance 0
+  polygon_t *box4 = make_box_polygon((vector_t){2, 0}, (vector_t){3, 1});
+  distance = find_convex_distance(support_polygon(box1, 0),
+                                  support_polygon(box4, 0));
+  assert(distance.collided);
+  assert(isclose(distance.distance, 0));
+  polygon_free(box1);
+  polygon_free(box2);
+  polygon_free(box3);
+  polygon_free(box4);
+  polygon_free(post);
+}
+
+void test_body_distance() {
+  rgb_color_t color = {0, 0, 0};
+  list_t *samples = list_init(101, free);
+  for (size_t i = 0; i <= 100; i++) {
+    vector_t *sample = malloc(sizeof(*sample));
+    *sample = (vector_t){10.0 * i, 10};
+    list_add(samples, sample);
+  }
+  body_t *ground =
+      body_init_heightfield(heightfield_init(samples, 0), color, NULL, NULL);
+  body_t *wheel = body_init_circle((vector_t){500, 15}, 2, 1, color, NULL,
+                                   NULL);
+  distance_info_t distance = find_body_distance(wheel, ground, 10);
+  assert(!distance.collided);
+  assert(isclose(distance.distance, 3));
+  assert(vec_isclose(distance.axis, (vector_t){0, -1}));
+  assert(vec_isclose(distance.point2, (vector_t){500, 10}));
+  // Beyond max_distance, nothing is found
+  distance = find_body_distance(wheel, ground, 2);
+  assert(!distance.collided && distance.distance == INFINITY);
+  // Sunk into the ground, the distance is minus the depth
+  body_set_centroid(wheel, (vector_t){500, 11});
+  distance = find_body_distance(ground, wheel, 0);
+  assert(distance.collided);
+  assert(isclose(distance.distance, -1));
+  assert(vec_isclose(distance.axis, (vector_t){0, 1}));
+  // The triangle's top vertex is closest to the box
+  body_t *triangle = body_init(make_triangle(), 1, color);
+  body_t *box = body_init(make_box((vector_t){1, 4}, (vector_t){2, 5}), 1,
+                          color);
+  distance = find_body_distance(triangle, box, 5);
+  assert(isclose(distance.distance, 2));
+  body_free(box);
+  body_free(triangle);
+  body_free(wheel);
+  body_free(ground);
+}
+
 int main(int argc, char *argv[]) {
   // Run all tests if there are no command-line arguments
   bool all_tests = argc == 1;
@@ -79,6 +601,18 @@ int main(int argc, char *argv[]) {
     read_testname(argv[1], testname, sizeof(testname));
   }
   DO_TEST(test_colliding)
+  DO_TEST(test_body_collision)
+  DO_TEST(test_concave_collision)
+  DO_TEST(test_contact_points)
+  DO_TEST(test_contact_cache)
+  DO_TEST(test_separating_axis_cache)
+  DO_TEST(test_tolerance_contact_cache)
+  DO_TEST(test_large_part_collision)
+  DO_TEST(test_heightfield_collision)
+  DO_TEST(test_chain_collision)
+  DO_TEST(test_circle_collision)
+  DO_TEST(test_convex_distance)
+  DO_TEST(test_body_distance)
 
   puts("Student Tests Passed Oh YEAHH 😎");
 }
@@ -0,0 +1,107 @@
+#include "heightfield.h"
+#include "list.h"
+#include "polygon.h"
+#include "test_util.h"
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+
+// Samples at x = 0, 10, 20, ... with heights 5, 6, 5, 6, ...
+heightfield_t *make_zigzag(size_t size) {
+  list_t *samples = list_init(size, free);
+  for (size_t i = 0; i < size; i++) {
+    vector_t *sample = malloc(sizeof(*sample));
+    *sample = (vector_t){10.0 * i, 5.0 + i % 2};
+    list_add(samples, sample);
+  }
+  return heightfield_init(samples, 0);
+}
+
+void test_heightfield_init() {
+  heightfield_t *heightfield = make_zigzag(5);
+  assert(heightfield_num_columns(heightfield) == 4);
+  aabb_t bounds = heightfield_get_bounds(heightfield);
+  assert(vec_isclose(bounds.min, (vector_t){0, 0}));
+  assert(vec_isclose(bounds.max, (vector_t){40, 6}));
+  heightfield_free(heightfield);
+}
+
+void test_heightfield_height() {
+  heightfield_t *heightfield = make_zigzag(5);
+  assert(isclose(heightfield_get_height(heightfield, 0), 5));
+  assert(isclose(heightfield_get_height(heightfield, 10), 6));
+  assert(isclose(heightfield_get_height(heightfield, 12.5), 5.75));
+  assert(isclose(heightfield_get_height(heightfield, 40), 5));
+  assert(isnan(heightfield_get_height(heightfield, -0.1)));
+  assert(isnan(heightfield_get_height(heightfield, 40.1)));
+  heightfield_free(heightfield);
+}
+
+void test_heightfield_find_columns() {
+  heightfield_t *heightfield = make_zigzag(1001);
+  size_t first, end;
+  heightfield_find_columns(heightfield, 123, 145, &first, &end);
+  assert(first == 12 && end == 15);
+  // A range inside one column
+  heightfield_find_columns(heightfield, 5001, 5002, &first, &end);
+  assert(first == 500 && end == 501);
+  // Columns that only touch the range at a sample are included
+  heightfield_find_columns(heightfield, 20, 30, &first, &end);
+  assert(first == 1 && end == 4);
+  // Ranges that overhang an end are clipped to the heightfield
+  heightfield_find_columns(heightfield, -50, 5, &first, &end);
+  assert(first == 0 && end == 1);
+  heightfield_find_columns(heightfield, 9995, 20000, &first, &end);
+  assert(first == 999 && end == 1000);
+  heightfield_find_columns(heightfield, -50, -1, &first, &end);
+  assert(first == end);
+  heightfield_find_columns(heightfield, 10001, 10002, &first, &end);
+  assert(first == end);
+  heightfield_free(heightfield);
+}
+
+void test_heightfield_shapes() {
+  heightfield_t *heightfield = make_zigzag(3);
+  polygon_t *column = heightfield_get_column(heightfield, 1);
+  vector_t corners[] = {{10, 0}, {10, 6}, {20, 5}, {20, 0}};
+  assert(polygon_size(column) == 4);
+  for (size_t i = 0; i < 4; i++) {
+    assert(vec_isclose(polygon_get_vertex(column, i), corners[i]));
+  }
+  assert(polygon_is_convex(column));
+  polygon_free(column);
+
+  // The outline encloses every column
+  polygon_t *outline = heightfield_get_outline(heightfield);
+  assert(polygon_size(outline) == 5);
+  assert(isclose(polygon_get_area(outline), 20 * 5 + 10));
+  polygon_free(outline);
+
+  // The same shapes can be built in an arena
+  arena_t *arena = arena_init(64);
+  column = heightfield_get_column_in(arena, heightfield, 1);
+  for (size_t i = 0; i < 4; i++) {
+    assert(vec_isclose(polygon_get_vertex(column, i), corners[i]));
+  }
+  outline = heightfield_get_outline_in(arena, heightfield);
+  assert(isclose(polygon_get_area(outline), 20 * 5 + 10));
+  arena_free(arena);
+  heightfield_free(heightfield);
+}
+
+int main(int argc, char *argv[]) {
+  // Run all tests if there are no command-line arguments
+  bool all_tests = argc == 1;
+  // Read test name from file
+  char testname[100];
+  if (!all_tests) {
+    read_testname(argv[1], testname, sizeof(testname));
+  }
+
+  DO_TEST(test_heightfield_init)
+  DO_TEST(test_heightfield_height)
+  DO_TEST(test_heightfield_find_columns)
+  DO_TEST(test_heightfield_shapes)
+
+  puts("heightfield_test PASS");
+}
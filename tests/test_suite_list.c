@@ -34,6 +34,20 @@ void test_list_size() {
   list_free(l);
 }
 
+void test_list_set() {
+  list_t *l = list_init(2, free);
+  size_t *n1 = malloc(sizeof(*n1));
+  size_t *n2 = malloc(sizeof(*n2));
+  *n1 = 1;
+  *n2 = 2;
+  list_add(l, n1);
+  assert(list_set(l, 0, n2) == n1);
+  free(n1);
+  assert(list_size(l) == 1);
+  assert(list_get(l, 0) == n2);
+  list_free(l);
+}
+
 void test_list_char() {
   list_t *l = list_init(1, free);
   assert(list_size(l) == 0);
@@ -154,6 +168,7 @@ int main(int argc, char *argv[]) {
 
   DO_TEST(test_list_size0)
   DO_TEST(test_list_size)
+  DO_TEST(test_list_set)
   DO_TEST(test_list_char)
   DO_TEST(test_list_vector)
   DO_TEST(test_list_add_resize)
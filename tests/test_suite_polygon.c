@@ -4,6 +4,10 @@
 #include <math.h>
 #include <stdlib.h>
 
+// The compiler may fuse a dot product into an FMA in one translation unit or
+// code path and not another, so dot products are compared within this
+const double DOT_TOLERANCE = 1e-12;
+
 // Make square at (+/-1, +/-1)
 list_t *make_square() {
   list_t *sq = list_init(4, free);
@@ -218,6 +222,410 @@ void test_weird_rotate() {
   list_free(w);
 }
 
+void test_polygon_from_list() {
+  list_t *w = make_weird();
+  polygon_t *polygon = polygon_from_list(w);
+  assert(polygon_size(polygon) == list_size(w));
+  for (size_t i = 0; i < list_size(w); i++) {
+    assert(vec_equal(polygon_get_vertex(polygon, i),
+                     *((vector_t *)list_get(w, i))));
+    assert(polygon_get_xs(polygon)[i] == ((vector_t *)list_get(w, i))->x);
+    assert(polygon_get_ys(polygon)[i] == ((vector_t *)list_get(w, i))->y);
+  }
+  assert(isclose(polygon_get_area(polygon), 23));
+  assert(vec_isclose(polygon_get_centroid(polygon),
+                     (vector_t){-223.0 / 138.0, -51.0 / 46.0}));
+
+  list_t *copy = polygon_to_list(polygon);
+  assert(list_size(copy) == list_size(w));
+  for (size_t i = 0; i < list_size(w); i++) {
+    assert(vec_equal(*((vector_t *)list_get(copy, i)),
+                     *((vector_t *)list_get(w, i))));
+  }
+  list_free(copy);
+  polygon_free(polygon);
+  list_free(w);
+}
+
+void test_polygon_add_vertex() {
+  polygon_t *polygon = polygon_init(0);
+  for (size_t i = 0; i < 100; i++) {
+    polygon_add_vertex(polygon, (vector_t){i, -(double)i});
+  }
+  assert(polygon_size(polygon) == 100);
+  for (size_t i = 0; i < 100; i++) {
+    assert(
+        vec_equal(polygon_get_vertex(polygon, i), (vector_t){i, -(double)i}));
+  }
+  polygon_set_vertex(polygon, 42, (vector_t){1, 2});
+  assert(vec_equal(polygon_get_vertex(polygon, 42), (vector_t){1, 2}));
+
+  polygon_t *copy = polygon_copy(polygon);
+  polygon_set_vertex(polygon, 42, VEC_ZERO);
+  assert(vec_equal(polygon_get_vertex(copy, 42), (vector_t){1, 2}));
+  polygon_free(copy);
+  polygon_free(polygon);
+}
+
+void test_polygon_arena() {
+  arena_t *arena = arena_init(64);
+  polygon_t *polygon = polygon_init_in(arena, 1);
+  // Grows within the arena past both its capacity and the arena's block
+  for (size_t i = 0; i < 100; i++) {
+    polygon_add_vertex(polygon, (vector_t){i, -(double)i});
+  }
+  assert(polygon_size(polygon) == 100);
+  assert(vec_equal(polygon_get_vertex(polygon, 99), (vector_t){99, -99}));
+  // Has no effect; the arena owns the memory
+  polygon_free(polygon);
+  assert(vec_equal(polygon_get_vertex(polygon, 1), (vector_t){1, -1}));
+
+  // The other constructors build the same polygons in the arena
+  list_t *vertices = make_square();
+  polygon_t *square = polygon_from_list_in(arena, vertices);
+  list_free(vertices);
+  polygon_t *copy = polygon_copy_in(arena, square);
+  polygon_t *normals = polygon_get_normals_in(arena, copy);
+  assert(polygon_size(normals) == 2);
+  size_t *extremes = polygon_get_extremes_in(arena, copy, normals);
+  size_t *expected_extremes = polygon_get_extremes(square, normals);
+  for (size_t i = 0; i < 4; i++) {
+    assert(vec_equal(polygon_get_vertex(copy, i),
+                     polygon_get_vertex(square, i)));
+    assert(extremes[i] == expected_extremes[i]);
+  }
+  free(expected_extremes);
+  arena_free(arena);
+
+  // Without an arena, they allocate on the heap
+  polygon_t *heap = polygon_init_in(NULL, 1);
+  polygon_add_vertex(heap, (vector_t){1, 2});
+  polygon_add_vertex(heap, (vector_t){3, 4});
+  assert(polygon_size(heap) == 2);
+  polygon_free(heap);
+}
+
+void test_polygon_transform() {
+  list_t *w = make_weird();
+  polygon_t *polygon = polygon_from_list(w);
+  // Rotate 90 degrees around (0, 2), as in test_weird_rotate()
+  polygon_rotate_vertices(polygon, M_PI / 2, (vector_t){0, 2});
+  polygon_rotate(w, M_PI / 2, (vector_t){0, 2});
+  polygon_translate_vertices(polygon, (vector_t){-10, -20});
+  polygon_translate(w, (vector_t){-10, -20});
+  for (size_t i = 0; i < list_size(w); i++) {
+    assert(vec_isclose(polygon_get_vertex(polygon, i),
+                       *((vector_t *)list_get(w, i))));
+  }
+  assert(isclose(polygon_get_area(polygon), 23));
+  polygon_free(polygon);
+  list_free(w);
+}
+
+void test_polygon_rigid_transform() {
+  list_t *w = make_weird();
+  polygon_t *local = polygon_from_list(w);
+  polygon_t *world = polygon_init(1);
+  polygon_transform(world, local, M_PI / 2, (vector_t){3, -4});
+  polygon_rotate(w, M_PI / 2, VEC_ZERO);
+  polygon_translate(w, (vector_t){3, -4});
+  assert(polygon_size(world) == list_size(w));
+  for (size_t i = 0; i < list_size(w); i++) {
+    assert(vec_isclose(polygon_get_vertex(world, i),
+                       *((vector_t *)list_get(w, i))));
+  }
+  // Transforming back recovers the original vertices
+  polygon_t *back = polygon_init(0);
+  polygon_transform(back, world, -M_PI / 2, (vector_t){4, 3});
+  for (size_t i = 0; i < polygon_size(local); i++) {
+    assert(vec_isclose(polygon_get_vertex(back, i),
+                       polygon_get_vertex(local, i)));
+  }
+  polygon_free(back);
+  polygon_free(world);
+  polygon_free(local);
+  list_free(w);
+}
+
+void test_polygon_transform_sizes() {
+  // Sizes 1 through 7 exercise both the vectorized loops and their tails
+  for (size_t i = 0; i < 7; i++) {
+    polygon_t *local = polygon_init(0);
+    for (size_t j = 0; j <= i; j++) {
+      polygon_add_vertex(local, (vector_t){j + 1.5, 2.0 * i - j});
+    }
+    polygon_t *world = polygon_init(0);
+    double angle = 0.3 * i - 1;
+    vector_t translation = {i, -2.0 * i};
+    polygon_transform(world, local, angle, translation);
+    assert(polygon_size(world) == i + 1);
+    list_t *expected = polygon_to_list(local);
+    polygon_rotate(expected, angle, VEC_ZERO);
+    polygon_translate(expected, translation);
+    for (size_t j = 0; j <= i; j++) {
+      assert(vec_isclose(polygon_get_vertex(world, j),
+                         *((vector_t *)list_get(expected, j))));
+    }
+    list_free(expected);
+    // Rotating in place about a pivot matches the list version too
+    expected = polygon_to_list(local);
+    polygon_rotate(expected, angle, (vector_t){1, -1});
+    polygon_rotate_vertices(local, angle, (vector_t){1, -1});
+    for (size_t j = 0; j <= i; j++) {
+      assert(vec_isclose(polygon_get_vertex(local, j),
+                         *((vector_t *)list_get(expected, j))));
+    }
+    list_free(expected);
+    polygon_free(world);
+    polygon_free(local);
+  }
+}
+
+void test_polygon_project() {
+  list_t *w = make_weird();
+  polygon_t *polygon = polygon_from_list(w);
+  double min, max;
+  polygon_project(polygon, (vector_t){1, 0}, &min, &max);
+  assert(isclose(min, -5) && isclose(max, 4));
+  polygon_project(polygon, (vector_t){0, 2}, &min, &max);
+  assert(isclose(min, -16) && isclose(max, 10));
+  polygon_free(polygon);
+  list_free(w);
+}
+
+void test_polygon_project_sizes() {
+  // Covers the vectorized loop, its remainder, and polygons too small for it
+  vector_t axis = {0.6, -1.7};
+  for (size_t size = 1; size <= 11; size++) {
+    polygon_t *polygon = polygon_init(size);
+    double expected_min = INFINITY;
+    double expected_max = -INFINITY;
+    for (size_t i = 0; i < size; i++) {
+      vector_t vertex = {sin(3.0 * i) * 10, cos(5.0 * i) * 7};
+      polygon_add_vertex(polygon, vertex);
+      double proj = vec_dot(vertex, axis);
+      expected_min = fmin(expected_min, proj);
+      expected_max = fmax(expected_max, proj);
+    }
+    double min, max;
+    polygon_project(polygon, axis, &min, &max);
+    assert(isclose(min, expected_min) && isclose(max, expected_max));
+    polygon_free(polygon);
+  }
+}
+
+void test_polygon_extreme_vertex() {
+  list_t *c = make_big_circ();
+  polygon_t *polygon = polygon_from_list(c);
+  size_t size = polygon_size(polygon);
+  assert(polygon_is_strictly_convex(polygon));
+  // From every start, climbing finds the vertex a full scan would
+  for (size_t k = 0; k < 50; k++) {
+    vector_t direction = {cos(0.37 * k), sin(0.37 * k)};
+    double min, max;
+    polygon_project(polygon, direction, &min, &max);
+    for (size_t start = 0; start < size; start += 7) {
+      size_t extreme = polygon_extreme_vertex(polygon, direction, start);
+      assert(within(DOT_TOLERANCE,
+                    vec_dot(polygon_get_vertex(polygon, extreme), direction),
+                    max));
+    }
+    size_t min_vertex = k;
+    size_t max_vertex = size - k;
+    double convex_min, convex_max;
+    polygon_project_convex(polygon, direction, &min_vertex, &max_vertex,
+                           &convex_min, &convex_max);
+    assert(within(DOT_TOLERANCE, convex_min, min));
+    assert(within(DOT_TOLERANCE, convex_max, max));
+  }
+  polygon_free(polygon);
+  list_free(c);
+
+  // A long straight edge, plain and turned so rounding dents it: each
+  // search along each edge's normal finds what a full scan would
+  for (size_t k = 0; k < 20; k++) {
+    size_t run = k < 10 ? 21 : 40;
+    polygon = polygon_init(run + 1);
+    for (size_t i = 0; i < run; i++) {
+      polygon_add_vertex(polygon, (vector_t){5.0 * i / (run - 1), 0});
+    }
+    polygon_add_vertex(polygon, (vector_t){2.5, 1});
+    polygon_rotate_vertices(polygon, 0.61 * k, VEC_ZERO);
+    polygon_translate_vertices(polygon, (vector_t){0.3 * k, -70.1});
+    assert(!polygon_is_strictly_convex(polygon));
+    polygon_t *normals = polygon_get_normals(polygon);
+    for (size_t i = 0; i < 2 * polygon_size(normals); i++) {
+      vector_t normal = polygon_get_vertex(normals, i / 2);
+      vector_t direction = i % 2 == 0 ? normal : vec_negate(normal);
+      double min, max;
+      polygon_project(polygon, direction, &min, &max);
+      for (size_t start = 0; start <= run; start++) {
+        size_t extreme = polygon_extreme_vertex(polygon, direction, start);
+        assert(within(DOT_TOLERANCE,
+                      vec_dot(polygon_get_vertex(polygon, extreme), direction),
+                      max));
+        size_t min_vertex = start;
+        size_t max_vertex = start;
+        double convex_min, convex_max;
+        polygon_project_convex(polygon, direction, &min_vertex, &max_vertex,
+                               &convex_min, &convex_max);
+        assert(within(DOT_TOLERANCE, convex_min, min));
+        assert(within(DOT_TOLERANCE, convex_max, max));
+      }
+      assert(within(DOT_TOLERANCE,
+                    vec_dot(polygon_support(polygon, direction), direction),
+                    max));
+    }
+    polygon_free(normals);
+    polygon_free(polygon);
+  }
+}
+
+void test_polygon_is_strictly_convex() {
+  list_t *sq = make_square();
+  polygon_t *polygon = polygon_from_list(sq);
+  assert(polygon_is_strictly_convex(polygon));
+  // A vertex in the middle of an edge makes a straight run
+  polygon_add_vertex(polygon, (vector_t){1, 0});
+  assert(!polygon_is_strictly_convex(polygon));
+  polygon_set_vertex(polygon, 4, (vector_t){1.5, 0});
+  assert(polygon_is_strictly_convex(polygon));
+  // Clockwise polygons are convex too
+  polygon_t *reversed = polygon_init(5);
+  for (size_t i = 5; i > 0; i--) {
+    polygon_add_vertex(reversed, polygon_get_vertex(polygon, i - 1));
+  }
+  assert(polygon_is_strictly_convex(reversed));
+  polygon_free(reversed);
+  // A dent
+  polygon_set_vertex(polygon, 4, (vector_t){0.5, 0});
+  assert(!polygon_is_strictly_convex(polygon));
+  polygon_free(polygon);
+  list_free(sq);
+}
+
+void test_polygon_extremes() {
+  list_t *sq = make_square();
+  polygon_t *square = polygon_from_list(sq);
+  polygon_t *normals = polygon_get_normals(square);
+  size_t *extremes = polygon_get_extremes(square, normals);
+  for (size_t i = 0; i < polygon_size(normals); i++) {
+    vector_t normal = polygon_get_vertex(normals, i);
+    double min, max;
+    polygon_project(square, normal, &min, &max);
+    vector_t lowest = polygon_get_vertex(square, extremes[2 * i]);
+    vector_t highest = polygon_get_vertex(square, extremes[2 * i + 1]);
+    assert(within(DOT_TOLERANCE, vec_dot(lowest, normal), min));
+    assert(within(DOT_TOLERANCE, vec_dot(highest, normal), max));
+  }
+  free(extremes);
+  polygon_free(normals);
+  polygon_free(square);
+  list_free(sq);
+}
+
+void test_polygon_normals() {
+  list_t *sq = make_square();
+  polygon_t *square = polygon_from_list(sq);
+  polygon_t *normals = polygon_get_normals(square);
+  // Opposite sides share an axis
+  assert(polygon_size(normals) == 2);
+  for (size_t i = 0; i < polygon_size(normals); i++) {
+    assert(isclose(vec_magn(polygon_get_vertex(normals, i)), 1));
+  }
+  assert(isclose(fabs(vec_dot(polygon_get_vertex(normals, 0),
+                              polygon_get_vertex(normals, 1))),
+                 0));
+  polygon_free(normals);
+  polygon_free(square);
+  list_free(sq);
+
+  list_t *w = make_weird();
+  polygon_t *weird = polygon_from_list(w);
+  normals = polygon_get_normals(weird);
+  size_t size = polygon_size(weird);
+  // Every edge is perpendicular to one of the normals
+  for (size_t i = 0; i < size; i++) {
+    vector_t edge = vec_subtract(polygon_get_vertex(weird, (i + 1) % size),
+                                 polygon_get_vertex(weird, i));
+    bool found = false;
+    for (size_t j = 0; j < polygon_size(normals); j++) {
+      found |= isclose(vec_dot(edge, polygon_get_vertex(normals, j)), 0);
+    }
+    assert(found);
+  }
+  // No two of its edges are parallel
+  assert(polygon_size(normals) == size);
+  polygon_free(normals);
+  polygon_free(weird);
+  list_free(w);
+}
+
+void test_polygon_decompose() {
+  // A comb with 3 teeth, listed clockwise
+  vector_t comb[] = {{0, 0}, {0, 3}, {1, 3}, {1, 1}, {2, 1}, {2, 3},
+                     {3, 3}, {3, 1}, {4, 1}, {4, 3}, {5, 3}, {5, 0}};
+  size_t size = sizeof(comb) / sizeof(*comb);
+  polygon_t *polygon = polygon_init(size);
+  for (size_t i = 0; i < size; i++) {
+    polygon_add_vertex(polygon, comb[i]);
+  }
+  assert(!polygon_is_convex(polygon));
+  list_t *parts = polygon_decompose(polygon);
+  // Hertel-Mehlhorn uses at most 4 times the 4 parts needed
+  assert(list_size(parts) >= 4 && list_size(parts) <= 16);
+  double area = 0;
+  for (size_t i = 0; i < list_size(parts); i++) {
+    polygon_t *part = list_get(parts, i);
+    assert(polygon_is_convex(part));
+    assert(polygon_get_area(part) > 0);
+    area += polygon_get_area(part);
+  }
+  assert(isclose(area, -polygon_get_area(polygon)));
+  list_free(parts);
+  polygon_free(polygon);
+
+  // Convex polygons come back whole
+  list_t *sq = make_square();
+  polygon = polygon_from_list(sq);
+  assert(polygon_is_convex(polygon));
+  parts = polygon_decompose(polygon);
+  assert(list_size(parts) == 1);
+  polygon_t *part = list_get(parts, 0);
+  for (size_t i = 0; i < list_size(sq); i++) {
+    assert(vec_equal(polygon_get_vertex(part, i),
+                     *((vector_t *)list_get(sq, i))));
+  }
+  list_free(parts);
+  polygon_free(polygon);
+  list_free(sq);
+}
+
+void test_polygon_simplify() {
+  // A square with a slightly bent point in the middle of each side
+  vector_t v[] = {{0, 0},    {1, -0.01}, {2, 0}, {2.01, 1},
+                  {2, 2},    {1, 2.01},  {0, 2}, {-0.01, 1}};
+  polygon_t *polygon = polygon_init(8);
+  for (size_t i = 0; i < 8; i++) {
+    polygon_add_vertex(polygon, v[i]);
+  }
+  polygon_t *simplified = polygon_simplify(polygon, 0.1);
+  assert(polygon_size(simplified) == 4);
+  for (size_t i = 0; i < 4; i++) {
+    assert(vec_equal(polygon_get_vertex(simplified, i), v[2 * i]));
+  }
+  polygon_free(simplified);
+  // Within a tight tolerance nothing can be dropped
+  simplified = polygon_simplify(polygon, 0.001);
+  assert(polygon_size(simplified) == 8);
+  polygon_free(simplified);
+  // Even a huge tolerance leaves a triangle
+  simplified = polygon_simplify(polygon, 100);
+  assert(polygon_size(simplified) == 3);
+  polygon_free(simplified);
+  polygon_free(polygon);
+}
+
 int main(int argc, char *argv[]) {
   // Run all tests? True if there are no command-line arguments
   bool all_tests = argc == 1;
@@ -239,6 +647,20 @@ int main(int argc, char *argv[]) {
   DO_TEST(test_weird_area_centroid)
   DO_TEST(test_weird_translate)
   DO_TEST(test_weird_rotate)
+  DO_TEST(test_polygon_from_list)
+  DO_TEST(test_polygon_add_vertex)
+  DO_TEST(test_polygon_arena)
+  DO_TEST(test_polygon_transform)
+  DO_TEST(test_polygon_rigid_transform)
+  DO_TEST(test_polygon_transform_sizes)
+  DO_TEST(test_polygon_project)
+  DO_TEST(test_polygon_project_sizes)
+  DO_TEST(test_polygon_extreme_vertex)
+  DO_TEST(test_polygon_is_strictly_convex)
+  DO_TEST(test_polygon_extremes)
+  DO_TEST(test_polygon_normals)
+  DO_TEST(test_polygon_decompose)
+  DO_TEST(test_polygon_simplify)
 
   puts("polygon_test PASS");
 }
@@ -0,0 +1,71 @@
+#include "pool.h"
+#include "list.h"
+#include "test_util.h"
+#include <assert.h>
+#include <stdalign.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+void test_pool_alloc() {
+  pool_t *pool = pool_init(sizeof(double[3]), 4);
+  assert(pool_record_size(pool) == sizeof(double[3]));
+  assert(pool_records(pool) == 0);
+  double *records[10];
+  // Grows past the first slab without moving earlier records
+  for (size_t i = 0; i < 10; i++) {
+    records[i] = pool_alloc(pool);
+    assert((uintptr_t)records[i] % alignof(max_align_t) == 0);
+    records[i][0] = i;
+    records[i][2] = -(double)i;
+  }
+  assert(pool_records(pool) == 10);
+  for (size_t i = 0; i < 10; i++) {
+    assert(records[i][0] == i && records[i][2] == -(double)i);
+  }
+  pool_free(pool);
+}
+
+void test_pool_release() {
+  pool_t *pool = pool_init(7, 2);
+  char *first = pool_alloc(pool);
+  char *second = pool_alloc(pool);
+  memset(first, 'a', 7);
+  memset(second, 'b', 7);
+  // pool_release() only needs the record, so it works as a freer
+  free_func_t freer = pool_release;
+  freer(first);
+  assert(pool_records(pool) == 1);
+  // Released records are reused before the pool grows
+  assert(pool_alloc(pool) == first);
+  assert(second[6] == 'b');
+  pool_release(second);
+  pool_release(first);
+  assert(pool_records(pool) == 0);
+  pool_free(pool);
+}
+
+void test_pool_free_all() {
+  pool_t *pool = pool_init(16, 1);
+  for (size_t i = 0; i < 100; i++) {
+    pool_alloc(pool);
+  }
+  // Freeing the pool releases every record, which ASan would catch
+  pool_free(pool);
+}
+
+int main(int argc, char *argv[]) {
+  // Run all tests if there are no command-line arguments
+  bool all_tests = argc == 1;
+  // Read test name from file
+  char testname[100];
+  if (!all_tests) {
+    read_testname(argv[1], testname, sizeof(testname));
+  }
+
+  DO_TEST(test_pool_alloc)
+  DO_TEST(test_pool_release)
+  DO_TEST(test_pool_free_all)
+
+  puts("pool_test PASS");
+}
@@ -228,6 +228,314 @@ void test_reaping() {
   scene_free(scene);
 }
 
+// A force creator that counts how many times it has been invoked
+void count_contact_calls(void *aux) { (*(size_t *)aux)++; }
+
+void test_contact_force_creator() {
+  scene_t *scene = scene_init();
+  body_t *body1 = body_init(make_shape(), 1, (rgb_color_t){0, 0, 0});
+  body_t *body2 = body_init(make_shape(), 1, (rgb_color_t){0, 0, 0});
+  body_set_centroid(body2, (vector_t){10, 0});
+  scene_add_body(scene, body1);
+  scene_add_body(scene, body2);
+  size_t calls = 0;
+  list_t *bodies = list_init(2, NULL);
+  list_add(bodies, body1);
+  list_add(bodies, body2);
+  contact_t *contact = force_get_contact(scene_add_contact_force_creator(
+      scene, count_contact_calls, &calls, bodies, NULL));
+
+  // A second force creator on the same pair shares its contact
+  size_t other_calls = 0;
+  bodies = list_init(2, NULL);
+  list_add(bodies, body1);
+  list_add(bodies, body2);
+  assert(force_get_contact(scene_add_contact_force_creator(
+             scene, count_contact_calls, &other_calls, bodies, NULL)) ==
+         contact);
+  bodies = list_init(2, NULL);
+  list_add(bodies, body2);
+  list_add(bodies, body1);
+  assert(force_get_contact(scene_add_contact_force_creator(
+             scene, count_contact_calls, &other_calls, bodies, NULL)) !=
+         contact);
+
+  // Always runs on the first tick, then not while the bodies are apart
+  scene_tick(scene, 1);
+  assert(calls == 1);
+  scene_tick(scene, 1);
+  assert(calls == 1);
+
+  // Runs on every tick while the bounding boxes overlap
+  body_set_centroid(body2, (vector_t){1.5, 1.5});
+  scene_tick(scene, 1);
+  scene_tick(scene, 1);
+  assert(calls == 3);
+
+  // Runs once more after the bodies separate
+  body_set_centroid(body2, (vector_t){10, 10});
+  scene_tick(scene, 1);
+  assert(calls == 4);
+  scene_tick(scene, 1);
+  assert(calls == 4);
+
+  // Is removed along with either body
+  scene_remove_body(scene, 1);
+  scene_tick(scene, 1);
+  body_set_centroid(body1, (vector_t){10, 10});
+  scene_tick(scene, 1);
+  assert(calls == 4);
+  assert(other_calls == 8);
+  scene_free(scene);
+}
+
+// Adds a force creator on the given bodies that counts its calls into aux
+force_t *add_counter(scene_t *scene, size_t *aux, body_t *body1,
+                     body_t *body2) {
+  list_t *bodies = list_init(2, NULL);
+  list_add(bodies, body1);
+  if (body2 != NULL) {
+    list_add(bodies, body2);
+  }
+  return scene_add_bodies_force_creator(scene, count_contact_calls, aux,
+                                        bodies, NULL);
+}
+
+void test_force_handles() {
+  scene_t *scene = scene_init();
+  body_t *body1 = body_init(make_shape(), 1, (rgb_color_t){0, 0, 0});
+  body_t *body2 = body_init(make_shape(), 1, (rgb_color_t){0, 0, 0});
+  body_t *body3 = body_init(make_shape(), 1, (rgb_color_t){0, 0, 0});
+  scene_add_body(scene, body1);
+  scene_add_body(scene, body2);
+  scene_add_body(scene, body3);
+  size_t calls[4] = {0, 0, 0, 0};
+  force_t *forces[] = {add_counter(scene, &calls[0], body1, NULL),
+                       add_counter(scene, &calls[1], body1, body2),
+                       add_counter(scene, &calls[2], body2, body3),
+                       add_counter(scene, &calls[3], body1, body3)};
+  assert(list_size(body_get_forces(body1)) == 3);
+  assert(list_size(body_get_forces(body2)) == 2);
+  assert(list_size(body_get_forces(body3)) == 2);
+  assert(force_get_contact(forces[0]) == NULL);
+
+  // A removed force creator is no longer called or referenced by its bodies
+  scene_remove_force_creator(scene, forces[1]);
+  assert(list_size(body_get_forces(body1)) == 2);
+  assert(list_size(body_get_forces(body2)) == 1);
+  assert(list_get(body_get_forces(body2), 0) == forces[2]);
+  scene_tick(scene, 1);
+  assert(calls[0] == 1 && calls[1] == 0 && calls[2] == 1 && calls[3] == 1);
+
+  // Removing a body reaps exactly the force creators acting on it
+  body_remove(body3);
+  scene_tick(scene, 1);
+  assert(calls[0] == 2 && calls[2] == 2 && calls[3] == 2);
+  assert(list_size(body_get_forces(body1)) == 1);
+  assert(list_get(body_get_forces(body1), 0) == forces[0]);
+  assert(list_size(body_get_forces(body2)) == 0);
+  scene_tick(scene, 1);
+  assert(calls[0] == 3 && calls[2] == 2 && calls[3] == 2);
+
+  // Removing by type unlinks the force creators at once and frees them by
+  // the end of the next tick, which ASan would catch
+  list_t *bodies = list_init(1, NULL);
+  list_add(bodies, body2);
+  size_t *aux = malloc(sizeof(*aux));
+  *aux = 0;
+  scene_add_bodies_force_creator(scene, count_contact_calls, aux, bodies,
+                                 free);
+  scene_remove_force(scene, count_contact_calls);
+  assert(list_size(body_get_forces(body1)) == 0);
+  assert(list_size(body_get_forces(body2)) == 0);
+  scene_tick(scene, 1);
+  assert(calls[0] == 3);
+  scene_free(scene);
+}
+
+typedef struct {
+  scene_t *scene;
+  size_t calls;
+} remover_aux_t;
+
+// Removes every force creator of its own type, including itself
+void remove_own_type(void *aux) {
+  remover_aux_t *remover = aux;
+  remover->calls++;
+  scene_remove_force(remover->scene, remove_own_type);
+}
+
+void test_remove_force_during_tick() {
+  scene_t *scene = scene_init();
+  body_t *body = body_init(make_shape(), 1, (rgb_color_t){0, 0, 0});
+  scene_add_body(scene, body);
+  remover_aux_t *remover = malloc(sizeof(*remover));
+  *remover = (remover_aux_t){.scene = scene, .calls = 0};
+  scene_add_bodies_force_creator(scene, remove_own_type, remover,
+                                 list_init(0, NULL), NULL);
+  size_t calls = 0;
+  add_counter(scene, &calls, body, NULL);
+
+  // The running force creator is not freed under itself, and the force
+  // creator after it still runs on the same tick
+  scene_tick(scene, 1);
+  assert(remover->calls == 1 && calls == 1);
+  scene_tick(scene, 1);
+  assert(remover->calls == 1 && calls == 2);
+  free(remover);
+  scene_free(scene);
+}
+
+void test_scene_records() {
+  scene_t *scene = scene_init_with_capacity(2, 1);
+  body_t *body = body_init(make_shape(), 1, (rgb_color_t){0, 0, 0});
+  scene_add_body(scene, body);
+  // Records grow past the initial capacity and can be used as force aux
+  for (size_t i = 0; i < 10; i++) {
+    list_t *bodies = list_init(1, NULL);
+    list_add(bodies, body);
+    size_t *aux = scene_alloc_record(scene, sizeof(size_t));
+    *aux = 0;
+    scene_add_bodies_force_creator(scene, count_contact_calls, aux, bodies,
+                                   pool_release);
+  }
+  scene_tick(scene, 1);
+  size_t *aux = scene_alloc_record(scene, sizeof(size_t));
+  pool_release(aux);
+  // Records still in use are released along with the scene
+  scene_alloc_record(scene, 2 * sizeof(double));
+  scene_free(scene);
+}
+
+void test_scene_body_arena() {
+  scene_t *scene = scene_init_with_capacity(2, 1);
+  arena_t *arena = scene_get_body_arena(scene);
+  rgb_color_t color = {0, 0, 0};
+  size_t *info = malloc(sizeof(*info));
+  body_t *ball =
+      body_init_with_info_in(arena, make_shape(), 1, color, info, free);
+  body_t *ground = body_init_with_info_in(arena, make_shape(), INFINITY, color,
+                                          NULL, NULL);
+  scene_add_body(scene, ball);
+  scene_add_body(scene, ground);
+  list_t *bodies = list_init(2, NULL);
+  list_add(bodies, ball);
+  list_add(bodies, ground);
+  size_t *calls = scene_alloc_record(scene, sizeof(size_t));
+  *calls = 0;
+  scene_add_bodies_force_creator(scene, count_contact_calls, calls, bodies,
+                                 pool_release);
+  scene_tick(scene, 1);
+  assert(*calls == 1);
+  // Removed bodies stay in the arena until the scene is freed
+  scene_remove_body(scene, 0);
+  scene_tick(scene, 1);
+  assert(scene_bodies(scene) == 1);
+  // The remaining body and the arena are released with the scene
+  scene_free(scene);
+}
+
+void test_unload_bodies() {
+  scene_t *scene = scene_init_with_capacity(2, 1);
+  rgb_color_t color = {0, 0, 0};
+  size_t *info = malloc(sizeof(*info));
+  body_t *ball = body_init_with_info_in(scene_get_body_arena(scene),
+                                        make_shape(), 1, color, info, free);
+  body_t *ground = body_init(make_shape(), INFINITY, color);
+  scene_add_body(scene, ball);
+  scene_add_body(scene, ground);
+  size_t *calls = scene_alloc_record(scene, sizeof(size_t));
+  *calls = 0;
+  add_counter(scene, calls, ball, ground);
+  list_t *bodies = list_init(2, NULL);
+  list_t *forces = list_init(1, NULL);
+
+  // Unloaded bodies and forces can be loaded back into the scene
+  scene_unload_bodies(scene, bodies, forces);
+  assert(scene_bodies(scene) == 0 && list_size(bodies) == 2);
+  scene_tick(scene, 1);
+  assert(*calls == 0);
+  scene_load_bodies(scene, bodies, forces);
+  assert(scene_bodies(scene) == 2 && list_size(bodies) == 0);
+  scene_tick(scene, 1);
+  assert(*calls == 1);
+
+  // Bodies and forces that are never loaded back are freed with the scene,
+  // which ASan would catch
+  scene_unload_bodies(scene, bodies, forces);
+  scene_free(scene);
+  list_free(bodies);
+  list_free(forces);
+}
+
+void test_static_bodies() {
+  scene_t *scene = scene_init();
+  body_t *ground = body_init_static(make_shape(), (rgb_color_t){0, 0, 0});
+  body_t *ball = body_init(make_shape(), 1, (rgb_color_t){0, 0, 0});
+  scene_add_body(scene, ground);
+  scene_add_body(scene, ball);
+  body_set_velocity(ground, (vector_t){1, 1});
+  body_set_velocity(ball, (vector_t){1, 1});
+  scene_tick(scene, 1);
+  assert(vec_isclose(body_get_centroid(ground), VEC_ZERO));
+  assert(vec_isclose(body_get_centroid(ball), (vector_t){1, 1}));
+  assert(scene_get_body(scene, 0) == ground);
+
+  // Static bodies are still removed and freed by the scene
+  scene_remove_body(scene, 0);
+  scene_tick(scene, 1);
+  assert(scene_bodies(scene) == 1);
+  assert(scene_get_body(scene, 0) == ball);
+  scene_free(scene);
+}
+
+void test_bullets() {
+  scene_t *scene = scene_init();
+  // A wall 0.2 thick at x = 10, and a box already touching the start
+  list_t *wall_shape = make_shape();
+  for (size_t i = 0; i < list_size(wall_shape); i++) {
+    vector_t *v = list_get(wall_shape, i);
+    *v = (vector_t){10 + v->x / 10, v->y * 5};
+  }
+  body_t *wall = body_init_static(wall_shape, (rgb_color_t){0, 0, 0});
+  body_t *floor = body_init_static(make_shape(), (rgb_color_t){0, 0, 0});
+  body_set_centroid(floor, (vector_t){0, -1.5});
+  scene_add_body(scene, wall);
+  scene_add_body(scene, floor);
+  body_t *bullet = body_init(make_shape(), 1, (rgb_color_t){0, 0, 0});
+  body_t *ghost = body_init(make_shape(), 1, (rgb_color_t){0, 0, 0});
+  body_set_bullet(bullet, true);
+  assert(body_is_bullet(bullet) && !body_is_bullet(ghost));
+  body_t *movers[] = {bullet, ghost};
+  size_t calls = 0;
+  for (size_t i = 0; i < 2; i++) {
+    scene_add_body(scene, movers[i]);
+    body_set_velocity(movers[i], (vector_t){100, 0});
+    body_t *others[] = {wall, floor};
+    for (size_t j = 0; j < 2; j++) {
+      list_t *bodies = list_init(2, NULL);
+      list_add(bodies, movers[i]);
+      list_add(bodies, others[j]);
+      scene_add_contact_force_creator(scene, count_contact_calls, &calls,
+                                      bodies, NULL);
+    }
+  }
+
+  // A long tick carries the ghost through the wall, but the bullet stops at
+  // it, even though it starts out touching the floor
+  scene_tick(scene, 0.2);
+  assert(isclose(body_get_centroid(ghost).x, 20));
+  vector_t stopped = body_get_centroid(bullet);
+  assert(stopped.x > 8.85 && stopped.x < 8.95);
+  assert(find_body_collision(bullet, wall).collided);
+  // Short ticks move the bullet as usual
+  body_set_centroid(bullet, VEC_ZERO);
+  body_set_velocity(bullet, (vector_t){1, 0});
+  scene_tick(scene, 0.2);
+  assert(isclose(body_get_centroid(bullet).x, 0.2));
+  scene_free(scene);
+}
+
 int main(int argc, char *argv[]) {
   // Run all tests if there are no command-line arguments
   bool all_tests = argc == 1;
@@ -242,6 +550,14 @@ int main(int argc, char *argv[]) {
   DO_TEST(test_force_creator)
   DO_TEST(test_force_creator_aux)
   DO_TEST(test_reaping)
+  DO_TEST(test_contact_force_creator)
+  DO_TEST(test_force_handles)
+  DO_TEST(test_remove_force_during_tick)
+  DO_TEST(test_scene_records)
+  DO_TEST(test_scene_body_arena)
+  DO_TEST(test_unload_bodies)
+  DO_TEST(test_static_bodies)
+  DO_TEST(test_bullets)
 
   puts("scene_test PASS");
 }